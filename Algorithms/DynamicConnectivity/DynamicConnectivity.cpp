@@ -0,0 +1,105 @@
+#ifndef DYNAMICCONNECTIVITY_CPP
+#define DYNAMICCONNECTIVITY_CPP
+
+#include "DynamicConnectivity.hpp"
+
+inline DynamicConnectivity::DynamicConnectivity(int n)
+    : n(n) {}
+
+inline void DynamicConnectivity::addEdge(int u, int v) {
+    if (u > v) std::swap(u, v);
+    open[{u, v}].push_back(static_cast<int>(queries.size()));
+}
+
+inline void DynamicConnectivity::removeEdge(int u, int v) {
+    if (u > v) std::swap(u, v);
+    auto it = open.find({u, v});
+    assert(it != open.end()); // The edge must be in the graph
+
+    // Any copy of a multiple edge can be removed: the graph is the same
+    intervals.push_back({u, v, it->second.back(), static_cast<int>(queries.size())});
+    it->second.pop_back();
+    if (it->second.empty()) {
+        open.erase(it);
+    }
+}
+
+inline void DynamicConnectivity::query(int u, int v) {
+    queries.emplace_back(u, v);
+}
+
+inline void DynamicConnectivity::countComponents() {
+    queries.emplace_back(-1, -1);
+}
+
+inline std::vector<int> DynamicConnectivity::solve() const {
+    int q = static_cast<int>(queries.size());
+    std::vector<int> answers(q);
+    if (q == 0) return answers;
+
+    // Edges still in the graph stay until the last query
+    std::vector<Interval> all = intervals;
+    for (const auto& [edge, starts] : open) {
+        for (int start : starts) {
+            all.push_back({edge.first, edge.second, start, q});
+        }
+    }
+
+    // Segment tree over the queries: each interval is split into O(log Q) nodes,
+    // whose edges are stored contiguously (first counted, then placed)
+    int size = static_cast<int>(std::bit_ceil(static_cast<unsigned>(q)));
+    std::vector<int> begin(2 * size + 1, 0);
+    auto forEachNode = [size](int left, int right, auto&& f) {
+        for (left += size, right += size; left < right; left /= 2, right /= 2) {
+            if (left & 1) f(left++);
+            if (right & 1) f(--right);
+        }
+    };
+    for (const Interval& interval : all) {
+        forEachNode(interval.start, interval.end, [&](int node) { ++begin[node + 1]; });
+    }
+    for (int node = 0; node < 2 * size; ++node) {
+        begin[node + 1] += begin[node];
+    }
+    std::vector<std::pair<int, int>> edges(begin[2 * size]);
+    std::vector<int> filled(begin.begin(), begin.end() - 1);
+    for (const Interval& interval : all) {
+        forEachNode(interval.start, interval.end, [&](int node) {
+            edges[filled[node]++] = {interval.u, interval.v};
+        });
+    }
+
+    // Depth-first traversal: join the edges of each node on the way down, and undo them on the way up
+    RollbackDisjointSetUnion dsu(n);
+    std::vector<int> snapshots(std::bit_width(static_cast<unsigned>(size)));
+    auto depth = [](int node) { return std::bit_width(static_cast<unsigned>(node)) - 1; };
+    int node = 1;
+    while (true) {
+        snapshots[depth(node)] = dsu.snapshot();
+        for (int i = begin[node]; i < begin[node + 1]; ++i) {
+            dsu.join(edges[i].first, edges[i].second);
+        }
+        if (node < size) {
+            node *= 2;
+            continue;
+        }
+
+        // Leaf: answer its query, if there is one
+        if (node - size < q) {
+            auto [u, v] = queries[node - size];
+            answers[node - size] = u < 0 ? dsu.count() : dsu.query(u, v);
+        }
+
+        // Leave every finished subtree, then go to the next sibling
+        while (node & 1) {
+            dsu.rollback(snapshots[depth(node)]);
+            node /= 2;
+        }
+        if (node == 0) break;
+        dsu.rollback(snapshots[depth(node)]);
+        ++node;
+    }
+    return answers;
+}
+
+#endif // DYNAMICCONNECTIVITY_CPP
@@ -0,0 +1,71 @@
+#ifndef DYNAMICCONNECTIVITY_HPP
+#define DYNAMICCONNECTIVITY_HPP
+
+#include <bit>      // For std::bit_ceil, std::bit_width
+#include <cassert>  // For assert
+#include <map>      // For std::map
+#include <utility>  // For std::pair, std::swap
+#include <vector>   // For std::vector
+#include "../../DataStructures/RollbackDisjointSetUnion/RollbackDisjointSetUnion.hpp"
+
+/**
+ * Offline dynamic connectivity: answers connectivity queries on a graph where edges are
+ * added and removed over time. Records all the operations first, then answers every query
+ * at once with a segment tree over time and a Disjoint Set Union with rollbacks.
+ */
+class DynamicConnectivity {
+public:
+    /**
+     * Constructs an empty graph with n nodes
+     * @param n Number of nodes
+     */
+    explicit DynamicConnectivity(int n);
+
+    /**
+     * Adds an edge between u and v. Multiple edges between the same nodes are allowed
+     * @param u First node
+     * @param v Second node
+     */
+    void addEdge(int u, int v);
+
+    /**
+     * Removes an edge between u and v, which must be in the graph
+     * @param u First node
+     * @param v Second node
+     */
+    void removeEdge(int u, int v);
+
+    /**
+     * Records a query: are u and v connected now?
+     * @param u First node
+     * @param v Second node
+     */
+    void query(int u, int v);
+
+    /**
+     * Records a query: how many connected components are there now?
+     */
+    void countComponents();
+
+    /**
+     * Answers all the recorded queries
+     * @return The answer to each query in order: 1 or 0 for query, the number of components for countComponents
+     */
+    std::vector<int> solve() const;
+
+private:
+    struct Interval {
+        int u, v;       // Ends of the edge
+        int start, end; // The edge is in the graph for the queries in [start, end)
+    };
+
+    int n;                                                // Number of nodes
+    std::vector<std::pair<int, int>> queries;             // Nodes of each query ({-1, -1} to count the components)
+    std::vector<Interval> intervals;                      // Edges that have been removed
+    std::map<std::pair<int, int>, std::vector<int>> open; // Start of each edge still in the graph
+};
+
+// Include the implementation file for templates
+#include "DynamicConnectivity.cpp"
+
+#endif // DYNAMICCONNECTIVITY_HPP
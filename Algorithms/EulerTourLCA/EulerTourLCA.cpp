@@ -0,0 +1,66 @@
+#ifndef EULERTOURLCA_CPP
+#define EULERTOURLCA_CPP
+
+#include "EulerTourLCA.hpp"
+
+template <template <typename, auto> class RMQ>
+EulerTourLCA<RMQ>::EulerTourLCA(const std::vector<std::vector<int>>& adjacency_list, int root)
+    : n(adjacency_list.size()),
+      tin(n),
+      order(n),
+      rmq(build(root, [&](int node) { return std::span<const int>(adjacency_list[node]); })) {}
+
+template <template <typename, auto> class RMQ>
+EulerTourLCA<RMQ>::EulerTourLCA(std::span<const int> offsets, std::span<const int> targets, int root)
+    : n(offsets.size() - 1),
+      tin(n),
+      order(n),
+      rmq(build(root, [&](int node) { return targets.subspan(offsets[node], offsets[node + 1] - offsets[node]); })) {}
+
+template <template <typename, auto> class RMQ>
+template <typename Neighbors>
+RMQ<int, EulerTourLCA<RMQ>::Min> EulerTourLCA<RMQ>::build(int root, Neighbors neighbors) {
+    // Explicit stack instead of recursion, so deep trees don't overflow the call stack
+    std::vector<int> parent(n, -1), edge(n, 0), stack;
+    stack.reserve(n);
+
+    int timer = 0;
+    tin[root] = timer, order[timer++] = root;
+    stack.push_back(root);
+    while (!stack.empty()) {
+        int node = stack.back();
+        std::span<const int> adj = neighbors(node);
+        if (edge[node] == static_cast<int>(adj.size())) {
+            stack.pop_back();
+            continue;
+        }
+
+        int next = adj[edge[node]++];
+        if (next == parent[node]) continue;
+
+        parent[next] = node;
+        tin[next] = timer, order[timer++] = next;
+        stack.push_back(next);
+    }
+
+    // Between two nodes in preorder, the parent with the smallest preorder index is the LCA
+    std::vector<int> parents(n, 0);
+    for (int i = 1; i < n; ++i) {
+        parents[i] = tin[parent[order[i]]];
+    }
+    return RMQ<int, Min>(parents.begin(), parents.end());
+}
+
+template <template <typename, auto> class RMQ>
+int EulerTourLCA<RMQ>::findLCA(int u, int v) const {
+    if (u == v) return u;
+
+    // The LCA is the parent of the shallowest node in (tin[u], tin[v]]
+    int left = tin[u], right = tin[v];
+    if (left > right) {
+        std::swap(left, right);
+    }
+    return order[rmq.Query(left + 1, right + 1)];
+}
+
+#endif // EULERTOURLCA_CPP
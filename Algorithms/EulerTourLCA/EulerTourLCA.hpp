@@ -0,0 +1,66 @@
+#ifndef EULERTOURLCA_HPP
+#define EULERTOURLCA_HPP
+
+#include <algorithm>
+#include <span>
+#include <vector>
+#include "../../DataStructures/LinearRMQ/LinearRMQ.hpp"
+
+/**
+ * Lowest Common Ancestor (LCA) implementation using an Euler tour and a range minimum query.
+ * Supports:
+ * - O(1) LCA queries after O(N log N) preprocessing with a SparseTable, or O(N) with a LinearRMQ
+ * - Trees given as adjacency lists or in compressed (CSR) form
+ *
+ * @tparam RMQ The range minimum query structure, used as RMQ<int, op> (SparseTable or LinearRMQ)
+ */
+template <template <typename, auto> class RMQ = SparseTable>
+class EulerTourLCA {
+public:
+    /**
+     * Constructs and preprocesses the LCA structure from an adjacency list
+     * @param adjacency_list Tree represented as adjacency list (0-based index)
+     * @param root Root node of the tree (default 0)
+     */
+    explicit EulerTourLCA(const std::vector<std::vector<int>>& adjacency_list, int root = 0);
+
+    /**
+     * Constructs and preprocesses the LCA structure from a tree in compressed sparse row form,
+     * where the neighbors of node u are targets[offsets[u]] to targets[offsets[u + 1] - 1]
+     * @param offsets Start of the neighbors of each node, with N + 1 entries (0-based index)
+     * @param targets Neighbors of all nodes, stored back to back
+     * @param root Root node of the tree (default 0)
+     */
+    EulerTourLCA(std::span<const int> offsets, std::span<const int> targets, int root = 0);
+
+    /**
+     * Finds the lowest common ancestor of two nodes
+     * @param u First node
+     * @param v Second node
+     * @return LCA of u and v
+     */
+    int findLCA(int u, int v) const;
+
+private:
+    // Operation of the range minimum query over preorder indices
+    static int Min(int a, int b) { return std::min(a, b); }
+
+    /**
+     * Runs an iterative DFS to number the nodes in preorder and builds the range minimum query
+     * @param root Root node of the tree
+     * @param neighbors Function returning the neighbors of a node as a std::span<const int>
+     * @return Range minimum query over the preorder index of the parent of each node, in preorder
+     */
+    template <typename Neighbors>
+    RMQ<int, Min> build(int root, Neighbors neighbors);
+
+    int n;                      // Number of nodes
+    std::vector<int> tin;       // Preorder index of each node
+    std::vector<int> order;     // Node at each preorder index
+    RMQ<int, Min> rmq;          // Minimum preorder index of a parent over a preorder range
+};
+
+// Include the implementation file for templates
+#include "EulerTourLCA.cpp"
+
+#endif // EULERTOURLCA_HPP
@@ -3,64 +3,93 @@
 
 #include "HLD.hpp"
 
-template <typename T, typename U, auto op, auto update>
-HLD<T, U, op, update>::HLD(const std::vector<std::vector<int>>& adjList) 
-    : adj(adjList),
-      n(adjList.size()),
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::HLD(const std::vector<std::vector<int>>& adjList, T identity, U identityUpdate)
+    : n(adjList.size()),
       counter(1),
+      identity(identity),
+      adj(adjList),
       size(n + 1, 1),
       preorder(n + 1),
       nxt(n + 1),
       parent(n + 1),
       depth(n + 1),
-      segTree(n + 1, T{}) {  // Initialize with identity element
+      segTree(MakeTree<Tree>(n + 1, identity, identityUpdate)),
+      reverseTree(MakeTree<ReverseTree>(n + 1, identity, identityUpdate)) {
 
     // Initialize with root at 1
     parent[1] = 1;
     nxt[1] = 1;
 
     // Perform decomposition
-    DFS_Size(1, 0);
-    DFS_HLD(1, 0);
+    DFS_Size();
+    DFS_HLD();
 }
 
-template <typename T, typename U, auto op, auto update>
-void HLD<T, U, op, update>::DFS_Size(int cur, int par) {
-    for (auto& child : adj[cur]) {
-        if (child == par) continue;
-        
-        depth[child] = depth[cur] + 1;
-        parent[child] = cur;
-        
-        DFS_Size(child, cur);
-        size[cur] += size[child];
-        
-        // Make the heaviest child first in adjacency list
-        if (size[child] > size[adj[cur][0]]) {
-            std::swap(child, adj[cur][0]);
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+void HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::DFS_Size() {
+    // Visit the nodes in preorder with an explicit stack, so every node comes after its parent
+    std::vector<int> order, stack = {1};
+    order.reserve(n);
+    while (!stack.empty()) {
+        int cur = stack.back();
+        stack.pop_back();
+        order.push_back(cur);
+
+        for (int child : adj[cur]) {
+            if (child == parent[cur]) continue;
+
+            depth[child] = depth[cur] + 1;
+            parent[child] = cur;
+            stack.push_back(child);
+        }
+    }
+
+    // In reverse preorder, the subtree sizes of all children are known when a node is reached
+    for (int i = static_cast<int>(order.size()) - 1; i >= 0; --i) {
+        int cur = order[i];
+        for (auto& child : adj[cur]) {
+            if (child == parent[cur]) continue;
+
+            size[cur] += size[child];
+
+            // Make the heaviest child first in adjacency list
+            if (adj[cur][0] == parent[cur] || size[child] > size[adj[cur][0]]) {
+                std::swap(child, adj[cur][0]);
+            }
         }
     }
 }
 
-template <typename T, typename U, auto op, auto update>
-void HLD<T, U, op, update>::DFS_HLD(int cur, int par) {
-    preorder[cur] = counter++;
-    for (int child : adj[cur]) {
-        if (child == par) continue;
-        
-        // Continue same chain or start new one
-        nxt[child] = (child == adj[cur][0] ? nxt[cur] : child);
-        DFS_HLD(child, cur);
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+void HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::DFS_HLD() {
+    std::vector<int> stack = {1};
+    while (!stack.empty()) {
+        int cur = stack.back();
+        stack.pop_back();
+        preorder[cur] = counter++;
+
+        // Push the children in reverse, so they are numbered in adjacency order with the heavy child first
+        for (auto it = adj[cur].rbegin(); it != adj[cur].rend(); ++it) {
+            int child = *it;
+            if (child == parent[cur]) continue;
+
+            // Continue same chain or start new one
+            nxt[child] = (child == adj[cur][0] ? nxt[cur] : child);
+            stack.push_back(child);
+        }
     }
 }
 
-template <typename T, typename U, auto op, auto update>
-void HLD<T, U, op, update>::UpdatePath(int u, int v, U value) {
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+void HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::UpdatePath(int u, int v, U value) {
+    stats.CountUpdate();
     while (nxt[u] != nxt[v]) {
         if (depth[nxt[u]] < depth[nxt[v]]) {
             std::swap(u, v);
         }
-        segTree.Update(preorder[nxt[u]], preorder[u], value);
+        UpdateRange(preorder[nxt[u]], preorder[u] + 1, value);
+        stats.CountChain();
         u = parent[nxt[u]];
     }
     
@@ -68,27 +97,118 @@ void HLD<T, U, op, update>::UpdatePath(int u, int v, U value) {
     if (preorder[u] > preorder[v]) {
         std::swap(u, v);
     }
-    segTree.Update(preorder[u], preorder[v], value);
+    UpdateRange(preorder[u], preorder[v] + 1, value);
+    stats.CountChain();
 }
 
-template <typename T, typename U, auto op, auto update>
-T HLD<T, U, op, update>::QueryPath(int u, int v) {
-    T result = T{};  // Initialize with identity
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+T HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::QueryPath(int u, int v) {
+    stats.CountQuery();
+
+    // `up` holds the path from u going up, `down` the path going down to v
+    T up = identity, down = identity;
     while (nxt[u] != nxt[v]) {
-        if (depth[nxt[u]] < depth[nxt[v]]) {
-            std::swap(u, v);
+        stats.CountChain();
+        stats.CountOps();
+        if (depth[nxt[u]] >= depth[nxt[v]]) {
+            // Climbing from u: the chain is walked from u up to its head, against preorder
+            up = op(up, QueryReversed(preorder[nxt[u]], preorder[u] + 1));
+            u = parent[nxt[u]];
+        } else {
+            // Descending to v: the chain is walked from its head down to v, in preorder
+            down = op(segTree.Query(preorder[nxt[v]], preorder[v] + 1), down);
+            v = parent[nxt[v]];
         }
-        result = op(result, segTree.Query(preorder[nxt[u]], preorder[u]));
-        u = parent[nxt[u]];
     }
     
-    // Query the remaining path
+    // Query the remaining path, which goes up if u is deeper and down otherwise
+    stats.CountChain();
+    stats.CountOps(2);
     if (preorder[u] > preorder[v]) {
-        std::swap(u, v);
+        up = op(up, QueryReversed(preorder[v], preorder[u] + 1));
+    } else {
+        up = op(up, segTree.Query(preorder[u], preorder[v] + 1));
     }
-    result = op(result, segTree.Query(preorder[u], preorder[v]));
     
+    return op(up, down);
+}
+
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+void HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::UpdateSubtree(int u, U value) {
+    stats.CountUpdate();
+
+    // The subtree of u is numbered contiguously in preorder
+    UpdateRange(preorder[u], preorder[u] + size[u], value);
+}
+
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+T HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::QuerySubtree(int u) {
+    stats.CountQuery();
+    return segTree.Query(preorder[u], preorder[u] + size[u]);
+}
+
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+OperationStats HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::Stats() const {
+    // The work of the trees, but the queries and updates of the HLD: each one makes several on the trees
+    OperationStats result = segTree.Stats();
+    if constexpr (Ordered) {
+        result += reverseTree.Stats();
+    }
+    OperationStats own = stats.Get();
+    result.queries = own.queries;
+    result.updates = own.updates;
+    result.opCalls += own.opCalls;
+    result.chainsCrossed += own.chainsCrossed;
     return result;
 }
 
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+void HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::ResetStats() {
+    stats.Reset();
+    segTree.ResetStats();
+    if constexpr (Ordered) {
+        reverseTree.ResetStats();
+    }
+}
+
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+void HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::UpdateRange(int left, int right, U value) {
+    if constexpr (HAS_RANGE_UPDATE) {
+        segTree.Update(left, right, value);
+        if constexpr (Ordered) {
+            reverseTree.Update(left, right, value);
+        }
+    } else {
+        // Point updates only: update every position
+        for (int i = left; i < right; ++i) {
+            segTree.Update(i, value);
+            if constexpr (Ordered) {
+                reverseTree.Update(i, value);
+            }
+        }
+    }
+}
+
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+T HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::QueryReversed(int left, int right) {
+    if constexpr (Ordered) {
+        return reverseTree.Query(left, right);
+    } else {
+        // The order doesn't matter for a commutative operation
+        return segTree.Query(left, right);
+    }
+}
+
+template <typename T, typename U, auto op, auto update, typename Tree, bool Ordered, typename StatsPolicy>
+template <typename Segtree>
+Segtree HLD<T, U, op, update, Tree, Ordered, StatsPolicy>::MakeTree(int size, T identity, U identityUpdate) {
+    if constexpr (std::is_same_v<Segtree, std::monostate>) {
+        return {};
+    } else if constexpr (std::is_constructible_v<Segtree, int, T, U>) {
+        return Segtree(size, identity, identityUpdate);
+    } else {
+        return Segtree(size, identity);
+    }
+}
+
 #endif // HLD_CPP
@@ -3,18 +3,45 @@
 
 #include <vector>
 #include <algorithm>
-#include "../DataStructures/SegmentTree/SegmentTree.hpp"
+#include <type_traits>
+#include <variant>
+#include "../../DataStructures/SegmentTree/SegmentTree.hpp"
+#include "../../DataStructures/LazyPropSegtree/LazyPropSegtree.hpp"
+
+// `op` with its arguments swapped, so a tree over it aggregates a range from right to left
+template <auto op>
+inline constexpr auto ReversedOp = [](auto a, auto b) { return op(b, a); };
+
+// The same segment tree type with a different operation
+template <typename Tree, auto newOp>
+struct RebindOp;
+
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy, auto newOp>
+struct RebindOp<SegmentTree<T, U, op, update, Layout, StatsPolicy>, newOp> {
+    using type = SegmentTree<T, U, newOp, update, Layout, StatsPolicy>;
+};
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy, auto newOp>
+struct RebindOp<LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>, newOp> {
+    using type = LazyPropSegtree<T, U, newOp, updVal, updLazy, StatsPolicy>;
+};
 
 /**
  * Heavy-Light Decomposition (HLD) implementation.
- * Supports path queries and updates on trees with customizable operations.
+ * Supports path and subtree queries and updates on trees with customizable operations.
  *
  * @tparam T The type of values stored in the tree
  * @tparam U The type of update values
  * @tparam op The associative operation function (e.g., sum, min, max)
- * @tparam update Function to update a value with an update value
+ * @tparam update Function to update a value with an update value, optionally taking the number of nodes the value
+ *                covers as a third argument (LazyPropSegtree only, e.g. to add to a sum)
+ * @tparam Tree The underlying segment tree: SegmentTree (point updates) or LazyPropSegtree (range updates)
+ * @tparam Ordered Whether `op` is not commutative, so paths have to be aggregated in order (keeps a second,
+ *                 reversed tree)
+ * @tparam StatsPolicy NoStats, or CountStats to count the path and subtree operations and the chains they cross
  */
-template <typename T, typename U, auto op, auto update>
+template <typename T, typename U, auto op, auto update, typename Tree = SegmentTree<T, U, op, update>,
+          bool Ordered = false, typename StatsPolicy = NoStats>
 class HLD {
     // Type trait to check if operation is valid
     template <typename F, typename A, typename B>
@@ -32,20 +59,38 @@ class HLD {
         std::is_invocable_r_v<T, F, A, B&> || 
         std::is_invocable_r_v<T, F, A&, B&>;
 
+    // Type trait to check if update is valid with the number of elements it updates (LazyPropSegtree only)
+    template <typename F, typename A, typename B>
+    static constexpr bool IsUpdateCallableWithLength =
+        std::is_invocable_r_v<T, F, A, B, int> || 
+        std::is_invocable_r_v<T, F, A&, B, int> ||
+        std::is_invocable_r_v<T, F, A, B&, int> || 
+        std::is_invocable_r_v<T, F, A&, B&, int>;
+
     static_assert(IsOpCallable<decltype(op), T, T>,
                 "Operation must be callable with (T, T) and return T");
-    static_assert(IsUpdateCallable<decltype(update), T, U>,
-                "Update must be callable with (T, U) and return T");
+    static_assert(IsUpdateCallable<decltype(update), T, U> || IsUpdateCallableWithLength<decltype(update), T, U>,
+                "Update must be callable with (T, U) or (T, U, int) and return T");
+
+    // Whether the underlying tree can update a range at once
+    static constexpr bool HAS_RANGE_UPDATE = requires(Tree& tree, U value) { tree.Update(0, 0, value); };
+
+    // Tree over the reversed operation, only kept for ordered paths
+    using ReverseTree = typename std::conditional_t<Ordered, RebindOp<Tree, ReversedOp<op>>,
+                                                    std::type_identity<std::monostate>>::type;
 
 public:
     /**
      * Constructs HLD structure from adjacency list
      * @param adj The tree represented as adjacency list (1-based index)
+     * @param identity The identity element of the operation (default T{})
+     * @param identityUpdate The identity element of the lazy update, only used by LazyPropSegtree (default U{})
      */
-    explicit HLD(const std::vector<std::vector<int>>& adj);
+    explicit HLD(const std::vector<std::vector<int>>& adj, T identity = T{}, U identityUpdate = U{});
 
     /**
      * Updates all nodes on the path from u to v
+     * O(log^2 N) with a LazyPropSegtree, O(length * log N) with a SegmentTree
      * @param u First node (1-based)
      * @param v Second node (1-based)
      * @param value Update value to apply
@@ -54,36 +99,103 @@ public:
 
     /**
      * Queries the path from u to v
+     * If Ordered, the nodes are combined in the order they appear on the path from u to v
      * @param u First node (1-based)
      * @param v Second node (1-based)
      * @return Result of applying operation along the path
      */
     T QueryPath(int u, int v);
 
+    /**
+     * Updates all nodes in the subtree of u
+     * O(log N) with a LazyPropSegtree, O(size * log N) with a SegmentTree
+     * @param u Root of the subtree (1-based)
+     * @param value Update value to apply
+     */
+    void UpdateSubtree(int u, U value);
+
+    /**
+     * Queries the subtree of u
+     * @param u Root of the subtree (1-based)
+     * @return Result of applying operation over the subtree
+     */
+    T QuerySubtree(int u);
+
+    /**
+     * Gets the work done since construction or the last ResetStats(). The queries, updates and chains crossed
+     * are counted by the HLD (with CountStats), the nodes visited and propagations by the underlying trees
+     * (if they use CountStats), and the calls to `op` by both
+     * @return The counters
+     */
+    OperationStats Stats() const;
+
+    /**
+     * Resets the counters returned by Stats(), including those of the underlying trees
+     */
+    void ResetStats();
+
 private:
     /**
-     * Computes subtree sizes and prepares for HLD
-     * @param cur Current node being processed
-     * @param par Parent of current node
+     * Computes parents, depths and subtree sizes, and moves the heavy child of each node first
+     */
+    void DFS_Size();
+
+    /**
+     * Performs the HLD decomposition, numbering the nodes in preorder with heavy children first
      */
-    void DFS_Size(int cur, int par);
+    void DFS_HLD();
 
     /**
-     * Performs the HLD decomposition
-     * @param cur Current node being processed
-     * @param par Parent of current node
+     * Updates the preorder positions [left, right) of the underlying tree
+     * @param left The left position (inclusive)
+     * @param right The right position (exclusive)
+     * @param value Update value to apply
      */
-    void DFS_HLD(int cur, int par);
+    void UpdateRange(int left, int right, U value);
+
+    /**
+     * Queries the preorder positions [left, right) of the underlying tree from right to left
+     * @param left The left position (inclusive)
+     * @param right The right position (exclusive)
+     * @return Result of applying operation from position right - 1 down to position left
+     */
+    T QueryReversed(int left, int right);
+
+    /**
+     * Constructs an underlying tree, passing identityUpdate only if it takes one
+     * @tparam Segtree The type of the tree
+     * @param size Number of positions
+     * @param identity The identity element of the operation
+     * @param identityUpdate The identity element of the lazy update
+     * @return The underlying tree
+     */
+    template <typename Segtree>
+    static Segtree MakeTree(int size, T identity, U identityUpdate);
 
     int n;                          // Number of nodes
     int counter;                    // Preorder counter
+    T identity;                     // Identity element of the operation
     std::vector<std::vector<int>> adj;  // Adjacency list
     std::vector<int> size;          // Subtree sizes
     std::vector<int> preorder;      // Preorder numbering
     std::vector<int> nxt;           // Head of heavy chain
     std::vector<int> parent;        // Parent nodes
     std::vector<int> depth;         // Node depths
-    SegmentTree<T, U, op, update> segTree;  // Underlying segment tree
+    Tree segTree;                   // Underlying segment tree
+    [[no_unique_address]] ReverseTree reverseTree; // Underlying tree over the reversed operation (if Ordered)
+    [[no_unique_address]] StatsPolicy stats;       // Counters of the path and subtree operations (empty with NoStats)
 };
 
+/**
+ * HLD over a LazyPropSegtree, for O(log^2 N) path updates and O(log N) subtree updates.
+ *
+ * @tparam updLazy The function to combine two lazy updates
+ * @tparam StatsPolicy Statistics policy of both the HLD and its Lazy Propagation Segment Tree
+ */
+template <typename T, typename U, auto op, auto update, auto updLazy, bool Ordered = false, typename StatsPolicy = NoStats>
+using LazyHLD = HLD<T, U, op, update, LazyPropSegtree<T, U, op, update, updLazy, StatsPolicy>, Ordered, StatsPolicy>;
+
+// Include the implementation file for templates
+#include "HLD.cpp"
+
 #endif // HLD_HPP
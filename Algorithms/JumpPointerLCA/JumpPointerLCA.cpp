@@ -0,0 +1,70 @@
+#ifndef JUMPPOINTERLCA_CPP
+#define JUMPPOINTERLCA_CPP
+
+#include "JumpPointerLCA.hpp"
+
+inline JumpPointerLCA::JumpPointerLCA(const std::vector<std::vector<int>>& adjacency_list)
+    : n(adjacency_list.size()),
+      adj(adjacency_list) {}
+
+inline void JumpPointerLCA::preprocess(int root) {
+    parent.assign(n, root);
+    jump.assign(n, root);
+    depth.assign(n, 0);
+
+    // Visit the nodes in BFS order, so every node comes after its parent
+    std::vector<int> order;
+    order.reserve(n);
+    order.push_back(root);
+    for (int i = 0; i < static_cast<int>(order.size()); ++i) {
+        int node = order[i];
+        for (int child : adj[node]) {
+            if (child == parent[node]) continue;
+
+            parent[child] = node;
+            depth[child] = depth[node] + 1;
+
+            // If the jumps of the parent and of its jump have the same length, merge them into one
+            int p = node, j = jump[node];
+            if (depth[p] - depth[j] == depth[j] - depth[jump[j]]) {
+                jump[child] = jump[j];
+            } else {
+                jump[child] = p;
+            }
+            order.push_back(child);
+        }
+    }
+}
+
+inline int JumpPointerLCA::kthAncestor(int node, int k) const {
+    if (k > depth[node]) return -1;
+
+    // Take the jump whenever it doesn't overshoot the target depth
+    int target = depth[node] - k;
+    while (depth[node] > target) {
+        node = depth[jump[node]] >= target ? jump[node] : parent[node];
+    }
+    return node;
+}
+
+inline int JumpPointerLCA::findLCA(int u, int v) const {
+    // Bring both nodes to the same depth
+    if (depth[u] < depth[v]) {
+        std::swap(u, v);
+    }
+    u = kthAncestor(u, depth[u] - depth[v]);
+
+    // Nodes at the same depth have jumps of the same length, so both can jump together
+    while (u != v) {
+        if (jump[u] != jump[v]) {
+            u = jump[u];
+            v = jump[v];
+        } else {
+            u = parent[u];
+            v = parent[v];
+        }
+    }
+    return u;
+}
+
+#endif // JUMPPOINTERLCA_CPP
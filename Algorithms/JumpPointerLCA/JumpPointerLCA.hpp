@@ -0,0 +1,55 @@
+#ifndef JUMPPOINTERLCA_HPP
+#define JUMPPOINTERLCA_HPP
+
+#include <vector>
+#include <algorithm>
+
+/**
+ * Lowest Common Ancestor (LCA) implementation using skew-binary jump pointers.
+ * Every node stores its parent and a single jump pointer, instead of a full binary lifting table.
+ * Supports:
+ * - O(log N) LCA queries after O(N) preprocessing
+ * - O(log N) k-th ancestor queries
+ */
+class JumpPointerLCA {
+public:
+    /**
+     * Constructs JumpPointerLCA structure from adjacency list
+     * @param adjacency_list Tree represented as adjacency list (0-based index)
+     */
+    explicit JumpPointerLCA(const std::vector<std::vector<int>>& adjacency_list);
+
+    /**
+     * Preprocesses the tree for LCA queries
+     * @param root Root node of the tree (default 0)
+     */
+    void preprocess(int root = 0);
+
+    /**
+     * Finds the k-th ancestor of a node
+     * @param node Starting node
+     * @param k Number of levels to go up
+     * @return k-th ancestor or -1 if it doesn't exist
+     */
+    int kthAncestor(int node, int k) const;
+
+    /**
+     * Finds the lowest common ancestor of two nodes
+     * @param u First node
+     * @param v Second node
+     * @return LCA of u and v
+     */
+    int findLCA(int u, int v) const;
+
+private:
+    int n;                              // Number of nodes
+    std::vector<std::vector<int>> adj;  // Adjacency list
+    std::vector<int> parent;            // Parent of each node (the root is its own parent)
+    std::vector<int> jump;              // Jump pointer of each node
+    std::vector<int> depth;             // Depth of each node
+};
+
+// Include the implementation file
+#include "JumpPointerLCA.cpp"
+
+#endif // JUMPPOINTERLCA_HPP
@@ -3,69 +3,162 @@
 
 #include "LCA.hpp"
 
-LCA::LCA(const std::vector<std::vector<int>>& adjacency_list) 
-    : adj(adjacency_list), 
-      n(adjacency_list.size()),
-      logN(static_cast<int>(std::log2(n)) + 1) {
-    
+inline LCA::LCA(const std::vector<std::vector<int>>& adjacency_list) 
+    : n(adjacency_list.size()),
+      logN(static_cast<int>(std::log2(n)) + 1),
+      adj(adjacency_list) {}
+
+inline LCA::LCA(Snapshot snapshot)
+    : n(static_cast<int>(snapshot.Field(0))),
+      logN(static_cast<int>(snapshot.Field(1))),
+      snapshot(std::move(snapshot)) {
+    std::span<const int> table = this->snapshot.Data<int>(0);
+    std::span<const int> depthTable = this->snapshot.Data<int>(1);
+    if (table.size() != static_cast<std::size_t>(logN) * n || depthTable.size() != static_cast<std::size_t>(n)) {
+        throw std::runtime_error("LCA: the snapshot doesn't hold all the tables");
+    }
+    mappedUp = table.data();
+    mappedDepth = depthTable.data();
+}
+
+inline void LCA::preprocess(int root) {
+    assert(mappedUp == nullptr); // A mapped structure has no adjacency list to preprocess
+
     // Initialize binary lifting table and depth array
-    up.assign(n, std::vector<int>(logN, -1));
+    up.assign(static_cast<std::size_t>(logN) * n, -1);
     depth.assign(n, 0);
-}
 
-void LCA::preprocess(int root) {
-    // Start DFS from root to build binary lifting tables
-    dfs(root, -1);
-}
+    // Visit the nodes in BFS order instead of recursing, so every node comes after its parent
+    std::vector<int> order;
+    order.reserve(n);
+    order.push_back(root);
+    depth[root] = 0;
 
-void LCA::dfs(int node, int parent) {
-    // Set first ancestor (immediate parent)
-    up[node][0] = parent;
-    
-    // Fill binary lifting table using dynamic programming
-    for (int j = 1; j < logN; ++j) {
-        if (up[node][j - 1] != -1) {
-            up[node][j] = up[up[node][j - 1]][j - 1];
+    for (int i = 0; i < static_cast<int>(order.size()); ++i) {
+        int node = order[i];
+
+        // Queue the children
+        for (int neighbor : adj[node]) {
+            if (neighbor == up[node]) continue;
+
+            up[neighbor] = node;
+            depth[neighbor] = depth[node] + 1;
+            order.push_back(neighbor);
         }
     }
-    
-    // Process children recursively
-    for (int neighbor : adj[node]) {
-        if (neighbor == parent) continue;
-        
-        depth[neighbor] = depth[node] + 1;
-        dfs(neighbor, node);
+
+    // Fill binary lifting table using dynamic programming, one level at a time
+    for (int j = 1; j < logN; ++j) {
+        const int* prev = up.data() + static_cast<std::size_t>(j - 1) * n;
+        int* cur = up.data() + static_cast<std::size_t>(j) * n;
+        for (int node = 0; node < n; ++node) {
+            cur[node] = prev[node] == -1 ? -1 : prev[prev[node]];
+        }
     }
 }
 
-int LCA::kthAncestor(int node, int k) const {
+inline int LCA::kthAncestor(int node, int k) const {
+    if (k > depths()[node]) return -1;
+
     // Climb the tree using binary representation of k
+    const int* table = upTable();
     for (int j = 0; j < logN && node != -1; ++j) {
         if (k & (1 << j)) {
-            node = up[node][j];
+            node = table[static_cast<std::size_t>(j) * n + node];
         }
     }
     return node;
 }
 
-int LCA::findLCA(int u, int v) const {
+inline int LCA::findLCA(int u, int v) const {
     // Bring both nodes to the same depth
-    if (depth[u] < depth[v]) {
+    const int* nodeDepth = depths();
+    if (nodeDepth[u] < nodeDepth[v]) {
         std::swap(u, v);
     }
     
     // Jump u up to depth of v
-    u = kthAncestor(u, depth[u] - depth[v]);
+    u = kthAncestor(u, nodeDepth[u] - nodeDepth[v]);
     if (u == v) return u;
     
     // Binary search for LCA
+    const int* table = upTable();
     for (int j = logN - 1; j >= 0; --j) {
-        if (up[u][j] != up[v][j]) {
-            u = up[u][j];
-            v = up[v][j];
+        const int* level = table + static_cast<std::size_t>(j) * n;
+        if (level[u] != level[v]) {
+            u = level[u];
+            v = level[v];
         }
     }
-    return up[u][0];
+    return table[u];
+}
+
+inline void LCA::findLCABatch(std::span<const std::pair<int, int>> queries, std::span<int> out, int root) const {
+    assert(out.size() >= queries.size());
+    assert(mappedUp == nullptr); // A mapped structure has no adjacency list to traverse
+    int q = queries.size();
+
+    // Group the queries by node: node u owns the entries ids[offset[u]] to ids[offset[u + 1] - 1]
+    std::vector<int> offset(n + 1, 0), ids(2 * q);
+    for (auto [u, v] : queries) {
+        ++offset[u + 1];
+        ++offset[v + 1];
+    }
+    for (int u = 0; u < n; ++u) {
+        offset[u + 1] += offset[u];
+    }
+    std::vector<int> fill(offset.begin(), offset.end() - 1);
+    for (int i = 0; i < q; ++i) {
+        ids[fill[queries[i].first]++] = i;
+        ids[fill[queries[i].second]++] = i;
+    }
+
+    // Iterative DFS: after a child is finished, its subtree is merged into the set of its parent
+    DisjointSetUnion dsu(n);
+    std::vector<int> ancestor(n), parent(n, -1), edge(n, 0), stack = {root};
+    std::vector<bool> visited(n, false);
+    visited[root] = true;
+    ancestor[root] = root;
+    while (!stack.empty()) {
+        int node = stack.back();
+        if (edge[node] < static_cast<int>(adj[node].size())) {
+            int next = adj[node][edge[node]++];
+            if (next == parent[node]) continue;
+
+            parent[next] = node;
+            visited[next] = true;
+            ancestor[next] = next;
+            stack.push_back(next);
+            continue;
+        }
+
+        // All children are merged: the LCA with any visited node is the ancestor of its set
+        for (int i = offset[node]; i < offset[node + 1]; ++i) {
+            auto [u, v] = queries[ids[i]];
+            int other = u == node ? v : u;
+            if (visited[other]) {
+                out[ids[i]] = ancestor[dsu.root(other)];
+            }
+        }
+
+        stack.pop_back();
+        if (parent[node] != -1) {
+            dsu.join(parent[node], node);
+            ancestor[dsu.root(node)] = parent[node];
+        }
+    }
+}
+
+inline void LCA::saveTo(const std::string& path) const {
+    assert(!up.empty() || mappedUp != nullptr); // preprocess must be called first
+    Snapshot::Save(path, Snapshot::KIND_LCA,
+                   {static_cast<std::uint64_t>(n), static_cast<std::uint64_t>(logN)},
+                   {{upTable(), static_cast<std::uint64_t>(logN) * n, sizeof(int)},
+                    {depths(), static_cast<std::uint64_t>(n), sizeof(int)}});
+}
+
+inline LCA LCA::mapFrom(const std::string& path) {
+    return LCA(Snapshot::Map(path, Snapshot::KIND_LCA));
 }
 
 #endif // LCA_CPP
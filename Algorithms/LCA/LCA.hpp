@@ -3,12 +3,19 @@
 
 #include <vector>
 #include <cmath>
+#include <cassert>
+#include <span>
+#include <string>
+#include <utility>
+#include "../../DataStructures/DisjointSetUnion/DisjointSetUnion.hpp"
+#include "../../Utilities/Snapshot/Snapshot.hpp"
 
 /**
  * Lowest Common Ancestor (LCA) implementation using binary lifting.
  * Supports:
- * - O(1) LCA queries after O(N log N) preprocessing
+ * - O(log N) LCA queries after O(N log N) preprocessing
  * - O(log N) k-th ancestor queries
+ * - Offline batches of LCA queries in near-linear time with Tarjan's algorithm, without preprocessing
  */
 class LCA {
 public:
@@ -40,19 +47,53 @@ public:
      */
     int findLCA(int u, int v) const;
 
-private:
     /**
-     * Performs DFS to compute binary lifting tables and depths
-     * @param node Current node being processed
-     * @param parent Parent of current node
+     * Finds the lowest common ancestors of a batch of pairs of nodes offline (Tarjan's algorithm).
+     * Does not need preprocess() to be called.
+     * @param queries Pairs of nodes {u, v}
+     * @param out Output buffer, out[i] receives the LCA of queries[i] (at least queries.size() entries)
+     * @param root Root node of the tree (default 0)
+     */
+    void findLCABatch(std::span<const std::pair<int, int>> queries, std::span<int> out, int root = 0) const;
+
+    /**
+     * Saves the preprocessed tables to a file, to be mapped later with mapFrom
+     * @param path Path of the file, replaced if it exists
+     * @throws std::runtime_error if the file can't be written
+     */
+    void saveTo(const std::string& path) const;
+
+    /**
+     * Maps tables saved with saveTo in memory, without the adjacency list.
+     * kthAncestor and findLCA work in place; preprocess and findLCABatch can't be used.
+     * @param path Path of the file
+     * @return The mapped structure, which keeps the file mapped as long as it (or a copy of it) exists
+     * @throws std::runtime_error if the file isn't an LCA snapshot
      */
-    void dfs(int node, int parent);
+    static LCA mapFrom(const std::string& path);
 
+private:
     int n;                          // Number of nodes
     int logN;                       // Maximum depth in binary representation
     std::vector<std::vector<int>> adj;  // Adjacency list
-    std::vector<std::vector<int>> up;   // Binary lifting table
+    std::vector<int> up;                // Binary lifting table, the 2^j-th ancestor of node is up[j * n + node]
     std::vector<int> depth;             // Depth of each node
+    Snapshot snapshot;                  // The mapped file, if the tables were mapped instead of built
+    const int* mappedUp = nullptr;      // Binary lifting table in the mapped file
+    const int* mappedDepth = nullptr;   // Depths in the mapped file
+
+    /**
+     * Constructs LCA structure over the tables of a mapped snapshot
+     * @param snapshot The mapped snapshot
+     */
+    explicit LCA(Snapshot snapshot);
+
+    // Binary lifting table and depths, whether they were built or mapped
+    const int* upTable() const { return mappedUp != nullptr ? mappedUp : up.data(); }
+    const int* depths() const { return mappedDepth != nullptr ? mappedDepth : depth.data(); }
 };
 
+// Include the implementation file
+#include "LCA.cpp"
+
 #endif // LCA_HPP
@@ -0,0 +1,107 @@
+#ifndef COMPRESSEDSEGMENTTREE_CPP
+#define COMPRESSEDSEGMENTTREE_CPP
+
+#include "CompressedSegmentTree.hpp"
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::CompressedSegmentTree(
+    ll start, ll end, const std::vector<std::pair<ll, ll>>& ranges, T identityOp, U identityUpdate)
+    : start_(start),
+      end_(end),
+      identityOp_(identityOp),
+      identityUpdate_(identityUpdate),
+      starts_(Compress(start, end, ranges)),
+      tree_(MakeTree()) {}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+T CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Query(ll left, ll right) {
+    left = std::max(left, start_), right = std::min(right, end_);
+    if (left > right) {
+        return identityOp_;
+    }
+    auto [first, last] = LeafRange(left, right);
+    return tree_.Query(first, last).value;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Update(ll left, ll right, U value) {
+    left = std::max(left, start_), right = std::min(right, end_);
+    if (left > right) {
+        return;
+    }
+    auto [first, last] = LeafRange(left, right);
+    tree_.Update(first, last, value);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+int CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Leaves() const {
+    return static_cast<int>(starts_.size());
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+OperationStats CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Stats() const {
+    return tree_.Stats();
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::ResetStats() {
+    tree_.ResetStats();
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+std::vector<long long> CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Compress(
+    ll start, ll end, const std::vector<std::pair<ll, ll>>& ranges) {
+    // A leaf starts at every left end, and right after every right end
+    std::vector<ll> starts = {start};
+    starts.reserve(2 * ranges.size() + 1);
+    for (auto [left, right] : ranges) {
+        left = std::max(left, start), right = std::min(right, end);
+        if (left > right) continue;
+        starts.push_back(left);
+        if (right < end) {
+            starts.push_back(right + 1);
+        }
+    }
+    std::sort(starts.begin(), starts.end());
+    starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+    return starts;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+typename CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Tree
+CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::MakeTree() const {
+    std::vector<Segment> leaves(starts_.size());
+    for (int i = 0; i < Leaves(); ++i) {
+        leaves[i] = {identityOp_, starts_[i], LeafEnd(i)};
+    }
+    return Tree(leaves.begin(), leaves.end(), Segment{identityOp_, 1, 0}, identityUpdate_);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+std::pair<int, int> CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::LeafRange(ll left, ll right) const {
+    // The last leaf starting at or before an index covers it
+    int first = LeavesUpTo(left) - 1, last = LeavesUpTo(right);
+    assert(starts_[first] == left && "Query/Update: range not given to the constructor");
+    assert(LeafEnd(last - 1) == right && "Query/Update: range not given to the constructor");
+    return {first, last};
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+int CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::LeavesUpTo(ll index) const {
+    // Branchless binary search: the comparison compiles to a conditional move, so there are no mispredictions
+    const ll* base = starts_.data();
+    int length = Leaves();
+    while (length > 1) {
+        int half = length / 2;
+        base = base[half] <= index ? base + half : base;
+        length -= half;
+    }
+    return static_cast<int>(base - starts_.data()) + (*base <= index);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+long long CompressedSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::LeafEnd(int leaf) const {
+    return leaf + 1 < Leaves() ? starts_[leaf + 1] - 1 : end_;
+}
+
+#endif // COMPRESSEDSEGMENTTREE_CPP
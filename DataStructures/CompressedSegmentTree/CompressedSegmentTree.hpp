@@ -0,0 +1,176 @@
+#ifndef COMPRESSEDSEGMENTTREE_HPP
+#define COMPRESSEDSEGMENTTREE_HPP
+
+#include <algorithm>   // For std::sort, std::unique
+#include <cassert>     // For assert
+#include <type_traits> // For std::is_invocable_v
+#include <utility>     // For std::pair
+#include <vector>      // For std::vector
+#include "../LazyPropSegtree/LazyPropSegtree.hpp"
+
+/**
+ * Coordinate-compressed Segment Tree with lazy propagation, for a range [start, end] as wide as a
+ * DynamicSegmentTree's, when every range that will be queried or updated is known up front.
+ * The ends of the ranges split the range into elementary intervals, which are the leaves of a flat
+ * LazyPropSegtree: each leaf remembers the interval it covers, so updates see the real range.
+ *
+ * Takes the same template arguments and has the same inclusive Query/Update as DynamicSegmentTree,
+ * so it can replace one without changing the functions passed to it.
+ *
+ * @tparam T The type of values stored in the tree (must be default constructible)
+ * @tparam U The type of lazy update values
+ * @tparam op The associative operation function (e.g., sum, min, max)
+ * @tparam updVal Function to update a value with a lazy update
+ * @tparam updLazy Function to combine lazy updates (takes node range into account)
+ * @tparam StatsPolicy NoStats, or CountStats to count the work of queries and updates (see Stats())
+ */
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy = NoStats>
+class CompressedSegmentTree {
+    using ll = long long;
+
+    // Type trait to check if operation is valid
+    template <typename F, typename A, typename B>
+    static constexpr bool IsBinaryOperation =
+        std::is_invocable_r_v<T, F, A, B> ||
+        std::is_invocable_r_v<T, F, A&, B> ||
+        std::is_invocable_r_v<T, F, A, B&> ||
+        std::is_invocable_r_v<T, F, A&, B&>;
+
+    // Type trait to check if lazy update is valid
+    template <typename F, typename A, typename B, typename C, typename D, typename E>
+    static constexpr bool IsLazyOperation =
+        std::is_invocable_v<F, A&, B&, C, D&, E&>;
+
+    // Compile-time validation of operation signatures
+    static_assert(IsBinaryOperation<decltype(op), T, T>,
+                "Operation must be callable with (T, T) and return T");
+    static_assert(IsBinaryOperation<decltype(updVal), T, U>,
+                "Value update must be callable with (T, U) and return T");
+    static_assert(IsLazyOperation<decltype(updLazy), U, T, U, ll, ll>,
+                "Lazy update must be callable with (U&, T&, U, ll&, ll&)");
+    static_assert(std::is_default_constructible_v<T>,
+                "T must be default constructible");
+
+public:
+    /**
+     * Constructs a segment tree covering [start, end], where every element is the identity
+     * @param start First index in range
+     * @param end Last index in range
+     * @param ranges Every range [left, right] that will be given to Query and Update, in any order
+     *               and with duplicates (clamped to [start, end] like the ranges of Query and Update)
+     * @param identityOp Identity element for the operation
+     * @param identityUpdate Identity element for lazy updates
+     */
+    CompressedSegmentTree(ll start, ll end, const std::vector<std::pair<ll, ll>>& ranges, T identityOp, U identityUpdate);
+
+    /**
+     * Range query operation. `left` must be a left end given to the constructor (or start), and `right` a right end (or end)
+     * @param left Start of query range (inclusive)
+     * @param right End of query range (inclusive)
+     * @return Result of applying operation over [left, right]
+     */
+    T Query(ll left, ll right);
+
+    /**
+     * Range update operation. `left` must be a left end given to the constructor (or start), and `right` a right end (or end)
+     * @param left Start of update range (inclusive)
+     * @param right End of update range (inclusive)
+     * @param value Update value to apply
+     */
+    void Update(ll left, ll right, U value);
+
+    /**
+     * Gets the number of leaves, i.e. of elementary intervals the ranges split [start, end] into
+     * @return The number of leaves
+     */
+    int Leaves() const;
+
+    /**
+     * Gets the work done by queries and updates since construction or the last ResetStats().
+     * Always zero with NoStats
+     * @return The counters
+     */
+    OperationStats Stats() const;
+
+    /**
+     * Resets the counters returned by Stats()
+     */
+    void ResetStats();
+
+private:
+    // The value of an interval [start, end] of the original range; start > end marks an empty one
+    struct Segment {
+        T value;
+        ll start;
+        ll end;
+    };
+
+    // `op` on intervals: the empty interval (padding of the tree) is the identity
+    static constexpr auto CombineSegments = [](const Segment& a, const Segment& b) -> Segment {
+        if (a.start > a.end) return b;
+        if (b.start > b.end) return a;
+        return {op(a.value, b.value), a.start, b.end};
+    };
+
+    // Applies an update to an interval, through `updLazy` with the interval it covers
+    static constexpr auto UpdateSegment = [](Segment segment, const U& value) -> Segment {
+        if (segment.start <= segment.end) {
+            // The lazy update of the tree is kept by LazyPropSegtree, only the value is needed
+            U scratch = value;
+            updLazy(scratch, segment.value, value, segment.start, segment.end);
+        }
+        return segment;
+    };
+
+    // Combines two lazy updates, giving `updLazy` a scratch value
+    static constexpr auto ComposeUpdates = [](U older, const U& newer) -> U {
+        T scratch{};
+        ll start = 0, end = 0;
+        updLazy(older, scratch, newer, start, end);
+        return older;
+    };
+
+    using Tree = LazyPropSegtree<Segment, U, CombineSegments, UpdateSegment, ComposeUpdates, StatsPolicy>;
+
+    ll start_;               // Start of range covered by the tree
+    ll end_;                 // End of range covered by the tree
+    T identityOp_;           // Identity element for the operation
+    U identityUpdate_;       // Identity element for lazy updates
+    std::vector<ll> starts_; // Sorted first indices of the leaves, starts_[0] == start_
+    Tree tree_;              // Flat tree over the leaves
+
+    /**
+     * Splits [start, end] before the left end and after the right end of every range
+     * @return The sorted first indices of the leaves
+     */
+    static std::vector<ll> Compress(ll start, ll end, const std::vector<std::pair<ll, ll>>& ranges);
+
+    /**
+     * Builds the tree over the leaves in starts_, all of them holding the identity
+     * @return The tree
+     */
+    Tree MakeTree() const;
+
+    /**
+     * Finds the leaves covering [left, right], which must start at `left` and end at `right`
+     * @return The first leaf and one past the last leaf
+     */
+    std::pair<int, int> LeafRange(ll left, ll right) const;
+
+    /**
+     * Counts the leaves starting at or before an index, like std::upper_bound on starts_
+     * @param index Index in [start, end]
+     * @return The number of leaves
+     */
+    int LeavesUpTo(ll index) const;
+
+    /**
+     * Gets the last index covered by a leaf
+     * @param leaf Index of the leaf
+     */
+    ll LeafEnd(int leaf) const;
+};
+
+#include "CompressedSegmentTree.cpp"
+
+#endif // COMPRESSEDSEGMENTTREE_HPP
@@ -0,0 +1,114 @@
+#ifndef CONCURRENTDISJOINTSETUNION_CPP
+#define CONCURRENTDISJOINTSETUNION_CPP
+
+#include "ConcurrentDisjointSetUnion.hpp"
+
+inline ConcurrentDisjointSetUnion::ConcurrentDisjointSetUnion(int n)
+    : n(n),
+      parent(n) {
+    for (int i = 0; i < n; ++i) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+inline int ConcurrentDisjointSetUnion::root(int x) {
+    while (true) {
+        int p = parent[x].load(std::memory_order_acquire);
+        if (p == x) return x;
+        int grandparent = parent[p].load(std::memory_order_acquire);
+        // Path halving: make x skip its parent. x is not a root, so no join writes its parent,
+        // and the only other writers are finds storing other ancestors of x: a plain store is
+        // enough, and losing a race only loses a bit of compression
+        if (p != grandparent) {
+            parent[x].store(grandparent, std::memory_order_release);
+        }
+        x = grandparent;
+    }
+}
+
+inline bool ConcurrentDisjointSetUnion::join(int x, int y) {
+    while (true) {
+        x = root(x);
+        y = root(y);
+
+        // Already in same set
+        if (x == y) return false;
+
+        // Randomized linking: the root with the lower priority joins the other one
+        if (priority(x) > priority(y)) {
+            std::swap(x, y);
+        }
+
+        // Only succeeds if x is still a root; otherwise another join linked it, so retry
+        int expected = x;
+        if (parent[x].compare_exchange_strong(expected, y,
+                                              std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+inline void ConcurrentDisjointSetUnion::joinBatch(std::span<const std::pair<int, int>> edges, int threads) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    parallelFor(0, edges.size(), threads, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            join(edges[i].first, edges[i].second);
+        }
+    });
+}
+
+inline bool ConcurrentDisjointSetUnion::query(int x, int y) {
+    while (true) {
+        x = root(x);
+        y = root(y);
+        if (x == y) return true;
+
+        // Roots never become roots again once linked. If x is still a root, it was one
+        // when y was found to be a different root, so the sets were different at that point
+        if (parent[x].load(std::memory_order_acquire) == x) return false;
+    }
+}
+
+inline int ConcurrentDisjointSetUnion::count(int threads) const {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::atomic<int> total = 0;
+    parallelFor(0, n, threads, [&](std::size_t lo, std::size_t hi) {
+        int roots = 0;
+        for (std::size_t i = lo; i < hi; ++i) {
+            roots += parent[i].load(std::memory_order_relaxed) == static_cast<int>(i);
+        }
+        total.fetch_add(roots, std::memory_order_relaxed);
+    });
+    return total.load(std::memory_order_relaxed);
+}
+
+inline std::uint32_t ConcurrentDisjointSetUnion::priority(int x) {
+    // Multiplying by an odd constant is a bijection modulo 2^32, so priorities never tie
+    return static_cast<std::uint32_t>(x) * 0x9E3779B1u;
+}
+
+template <typename F>
+void ConcurrentDisjointSetUnion::parallelFor(std::size_t begin, std::size_t end, int threads, F body) {
+    // Small ranges are not worth starting threads for
+    threads = static_cast<int>(std::min<std::size_t>(threads, (end - begin) / PARALLEL_GRAIN));
+    if (threads <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    std::size_t chunk = (end - begin + threads - 1) / threads;
+    for (std::size_t lo = begin; lo < end; lo += chunk) {
+        std::size_t hi = std::min(end, lo + chunk);
+        workers.emplace_back([lo, hi, &body] { body(lo, hi); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // CONCURRENTDISJOINTSETUNION_CPP
@@ -0,0 +1,87 @@
+#ifndef CONCURRENTDISJOINTSETUNION_HPP
+#define CONCURRENTDISJOINTSETUNION_HPP
+
+#include <algorithm> // For std::min, std::max
+#include <atomic>    // For std::atomic
+#include <cstddef>   // For std::size_t
+#include <cstdint>   // For std::uint32_t
+#include <span>      // For std::span
+#include <thread>    // For std::thread
+#include <utility>   // For std::pair, std::swap
+#include <vector>    // For std::vector
+
+/**
+ * Disjoint Set Union (DSU) data structure that can be used by many threads at once.
+ * Parents are atomic words linked with compare-and-swap, finds use path halving, and
+ * roots are linked by a fixed pseudo-random priority (Jayanti-Tarjan randomized linking).
+ * No operation takes a lock.
+ */
+class ConcurrentDisjointSetUnion {
+public:
+    /**
+     * Constructs a DSU with n elements
+     * @param n Number of elements
+     */
+    explicit ConcurrentDisjointSetUnion(int n);
+
+    /**
+     * Finds the root of element x with path halving
+     * @param x Element to find
+     * @return Root of x at some point during the call
+     */
+    int root(int x);
+
+    /**
+     * Joins two sets containing x and y
+     * @param x First element
+     * @param y Second element
+     * @return True if the sets were merged by this call, false if they were already the same
+     */
+    bool join(int x, int y);
+
+    /**
+     * Joins the sets containing the two ends of every edge, splitting the edges among threads
+     * @param edges Pairs of elements to join
+     * @param threads Number of threads to use (0 for std::thread::hardware_concurrency)
+     */
+    void joinBatch(std::span<const std::pair<int, int>> edges, int threads = 0);
+
+    /**
+     * Checks if x and y are in the same set
+     * @param x First element
+     * @param y Second element
+     * @return True if x and y are in the same set
+     */
+    bool query(int x, int y);
+
+    /**
+     * Gets the total number of sets by counting the roots.
+     * Exact when no join runs at the same time
+     * @param threads Number of threads to use (0 for std::thread::hardware_concurrency)
+     * @return Number of disjoint sets
+     */
+    int count(int threads = 1) const;
+
+private:
+    static constexpr int PARALLEL_GRAIN = 1 << 14; // Minimum number of elements or edges per thread
+
+    int n;                                 // Total number of elements
+    std::vector<std::atomic<int>> parent;  // Parent of each element (itself for roots)
+
+    /**
+     * Priority used to link roots: a bijection of [0, 2^32) that looks random,
+     * so that no input order builds deep trees
+     */
+    static std::uint32_t priority(int x);
+
+    /**
+     * Splits [begin, end) into one contiguous chunk per thread, and runs body(lo, hi) on each
+     */
+    template <typename F>
+    static void parallelFor(std::size_t begin, std::size_t end, int threads, F body);
+};
+
+// Include the implementation file for templates
+#include "ConcurrentDisjointSetUnion.cpp"
+
+#endif // CONCURRENTDISJOINTSETUNION_HPP
@@ -0,0 +1,146 @@
+#ifndef CONCURRENTSEGMENTTREE_CPP
+#define CONCURRENTSEGMENTTREE_CPP
+
+#include "ConcurrentSegmentTree.hpp"
+
+// Constructor from a range of elements
+template <typename T, typename U, auto op, auto update>
+template <std::forward_iterator Iter>
+    requires std::convertible_to<std::iter_value_t<Iter>, T>
+ConcurrentSegmentTree<T, U, op, update>::ConcurrentSegmentTree(Iter start, Iter end, T identity)
+    : size_(std::distance(start, end)), identity_(identity), tree_(2 * size_) {
+    // No other thread can see the tree yet, so relaxed stores are enough
+    for (int i = 0; i < size_; ++i, ++start) {
+        tree_[size_ + i].store(*start, std::memory_order_relaxed);
+    }
+    for (int i = size_ - 1; i > 0; --i) {
+        tree_[i].store(op(tree_[2 * i].load(std::memory_order_relaxed), tree_[2 * i + 1].load(std::memory_order_relaxed)),
+                       std::memory_order_relaxed);
+    }
+}
+
+// Constructor with a given size and identity element
+template <typename T, typename U, auto op, auto update>
+ConcurrentSegmentTree<T, U, op, update>::ConcurrentSegmentTree(int size, T identity)
+    : size_(size), identity_(identity), tree_(2 * size_) {
+    for (auto& node : tree_) {
+        node.store(identity_, std::memory_order_relaxed);
+    }
+}
+
+// Query function
+template <typename T, typename U, auto op, auto update>
+T ConcurrentSegmentTree<T, U, op, update>::Query(int left, int right) const {
+    for (int attempt = 0; attempt < OPTIMISTIC_READS; ++attempt) {
+        std::uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before % 2 == 1) {
+            // An update is writing: let it finish instead of reading nodes it is changing
+            std::this_thread::yield();
+            continue;
+        }
+
+        T result = QueryNodes(left, right);
+
+        // The node loads are acquires, so this load can't move before them. If an update wrote any
+        // of the nodes that were read, the sequence was made odd before it, so it is seen changed here
+        if (sequence_.load(std::memory_order_relaxed) == before) {
+            return result;
+        }
+    }
+
+    // Updates keep running into this query: stop them while it reads the tree
+    waiting_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(writer_);
+    waiting_.fetch_sub(1, std::memory_order_relaxed);
+    return QueryNodes(left, right);
+}
+
+// Update function
+template <typename T, typename U, auto op, auto update>
+void ConcurrentSegmentTree<T, U, op, update>::Update(int pos, U value) {
+    BeginWrite();
+    UpdateNodes(pos, value);
+    EndWrite();
+}
+
+// Batched update function
+template <typename T, typename U, auto op, auto update>
+void ConcurrentSegmentTree<T, U, op, update>::UpdateBatch(std::span<const std::pair<int, U>> updates) {
+    BeginWrite();
+    for (const auto& [pos, value] : updates) {
+        UpdateNodes(pos, value);
+    }
+    EndWrite();
+}
+
+// Access the element at index
+template <typename T, typename U, auto op, auto update>
+T ConcurrentSegmentTree<T, U, op, update>::operator[](int index) const {
+    return Load(size_ + index);
+}
+
+// Query the nodes once
+template <typename T, typename U, auto op, auto update>
+T ConcurrentSegmentTree<T, U, op, update>::QueryNodes(int left, int right) const {
+    T left_result = identity_, right_result = identity_;
+    left += size_, right += size_;
+
+    while (left < right) {
+        if (left % 2 == 1) {
+            left_result = op(left_result, Load(left++));
+        }
+        if (right % 2 == 1) {
+            right_result = op(Load(--right), right_result);
+        }
+        left /= 2, right /= 2;
+    }
+
+    return op(left_result, right_result);
+}
+
+// Update a leaf and its ancestors
+template <typename T, typename U, auto op, auto update>
+void ConcurrentSegmentTree<T, U, op, update>::UpdateNodes(int pos, const U& value) {
+    pos += size_;
+    Store(pos, update(Load(pos), value));
+    for (pos /= 2; pos > 0; pos /= 2) {
+        Store(pos, op(Load(2 * pos), Load(2 * pos + 1)));
+    }
+}
+
+// Start of a write
+template <typename T, typename U, auto op, auto update>
+void ConcurrentSegmentTree<T, U, op, update>::BeginWrite() {
+    // The mutex is not fair: without this, an update would lock it again right after unlocking it,
+    // and a query waiting for it could wait for as long as updates keep coming
+    while (waiting_.load(std::memory_order_relaxed) > 0) {
+        std::this_thread::yield();
+    }
+    writer_.lock();
+
+    // Only the writer holding the mutex changes the sequence. The node stores that follow are
+    // releases, so a query that reads one of them also sees this odd sequence
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// End of a write
+template <typename T, typename U, auto op, auto update>
+void ConcurrentSegmentTree<T, U, op, update>::EndWrite() {
+    // A query that sees the even sequence also sees every node written before it
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    writer_.unlock();
+}
+
+// Load a node
+template <typename T, typename U, auto op, auto update>
+T ConcurrentSegmentTree<T, U, op, update>::Load(int pos) const {
+    return tree_[pos].load(std::memory_order_acquire);
+}
+
+// Store a node
+template <typename T, typename U, auto op, auto update>
+void ConcurrentSegmentTree<T, U, op, update>::Store(int pos, const T& value) {
+    tree_[pos].store(value, std::memory_order_release);
+}
+
+#endif // CONCURRENTSEGMENTTREE_CPP
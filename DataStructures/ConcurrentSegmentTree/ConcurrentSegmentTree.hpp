@@ -0,0 +1,148 @@
+#ifndef CONCURRENTSEGMENTTREE_HPP
+#define CONCURRENTSEGMENTTREE_HPP
+
+#include <atomic>      // For std::atomic
+#include <concepts>    // For std::convertible_to
+#include <cstdint>     // For std::uint64_t
+#include <iterator>    // For std::forward_iterator, std::iter_value_t
+#include <mutex>       // For std::mutex, std::lock_guard
+#include <span>        // For std::span
+#include <thread>      // For std::this_thread::yield
+#include <type_traits> // For std::is_invocable_r_v, std::is_trivially_copyable_v
+#include <utility>     // For std::pair
+#include <vector>      // For std::vector
+
+/**
+ * Segment Tree that many threads can query while other threads update it.
+ * The nodes are atomic, and a sequence lock (seqlock) makes every query see the tree between two
+ * updates: an update makes the sequence odd while it writes, and a query that saw the sequence
+ * change retries. Queries take no lock and write nothing, unless updates keep invalidating them:
+ * then they stop the updates for one read of the tree, so that they always finish.
+ * Updates are serialized by a mutex.
+ *
+ * @tparam T The type of elements stored in the segment tree (trivially copyable, with a lock-free std::atomic<T>).
+ * @tparam U The type of the update value.
+ * @tparam op The operation function (e.g., sum, min, max).
+ * @tparam update The update function to apply to elements.
+ */
+template <typename T, typename U, auto op, auto update>
+class ConcurrentSegmentTree {
+    // Helper to check if `op` is callable with T or T&
+    template <typename F, typename A, typename B>
+    static constexpr bool IsOpCallable =
+        std::is_invocable_r_v<T, F, A, B> || std::is_invocable_r_v<T, F, A&, B> ||
+        std::is_invocable_r_v<T, F, A, B&> || std::is_invocable_r_v<T, F, A&, B&>;
+
+    // Helper to check if `update` is callable with T and U or T& and U&
+    template <typename F, typename A, typename B>
+    static constexpr bool IsUpdateCallable =
+        std::is_invocable_r_v<T, F, A, B> || std::is_invocable_r_v<T, F, A&, B> ||
+        std::is_invocable_r_v<T, F, A, B&> || std::is_invocable_r_v<T, F, A&, B&>;
+
+    // Ensure `op` and `update` are valid, and that nodes can be atomic
+    static_assert(IsOpCallable<decltype(op), T, T>,
+                  "`op` must be callable with T or T& as arguments");
+    static_assert(IsUpdateCallable<decltype(update), T, U>,
+                  "`update` must be callable with T and U or T& and U& as arguments");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "T must be trivially copyable to be stored in std::atomic");
+    static_assert(std::atomic<T>::is_always_lock_free,
+                  "std::atomic<T> must be lock-free, or every query would take the lock of each node it reads");
+
+public:
+    /**
+     * Constructs a ConcurrentSegmentTree from a range of elements.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     * @param identity The identity element for the operation (e.g., 0 for sum, INF for min).
+     */
+    template <std::forward_iterator Iter>
+        requires std::convertible_to<std::iter_value_t<Iter>, T>
+    explicit ConcurrentSegmentTree(Iter start, Iter end, T identity);
+
+    /**
+     * Constructs a ConcurrentSegmentTree with a given size and identity element.
+     * All entries are initially set to the identity.
+     *
+     * @param size The number of elements in the tree.
+     * @param identity The identity element for the operation.
+     */
+    explicit ConcurrentSegmentTree(int size, T identity);
+
+    /**
+     * Queries the range [left, right). Can run on any number of threads, alongside updates.
+     * Retries while an update is running or has run during the query, so `op` may be called
+     * on values that mix two versions of the tree; only the result of a consistent version
+     * is returned. After OPTIMISTIC_READS failed attempts, takes the update mutex instead.
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @return The result of the operation over the range, between two updates.
+     */
+    T Query(int left, int right) const;
+
+    /**
+     * Updates the element at the given position. Queries running at the same time see the tree
+     * either before or after the update.
+     *
+     * @param pos The position to update.
+     * @param value The value to apply.
+     */
+    void Update(int pos, U value);
+
+    /**
+     * Applies many point updates at once, in the order of `updates`. Queries running at the same
+     * time see the tree either before all of them or after all of them.
+     *
+     * @param updates The pairs {pos, value}, applied as Update(pos, value).
+     */
+    void UpdateBatch(std::span<const std::pair<int, U>> updates);
+
+    /**
+     * Gets the element at the given index: the value of its leaf, read atomically.
+     *
+     * @param index The index to access.
+     * @return The element at the index.
+     */
+    T operator[](int index) const;
+
+private:
+    static constexpr int OPTIMISTIC_READS = 4; // Attempts of a query before it takes the update mutex
+
+    int size_;                          // Number of elements in the tree
+    T identity_;                        // Identity element for the operation
+    std::vector<std::atomic<T>> tree_;  // Nodes of the bottom-up binary layout: node i has children 2i and 2i + 1
+    std::atomic<std::uint64_t> sequence_ = 0; // Odd while an update is writing, bumped twice per update
+    mutable std::mutex writer_;         // Held by updates, and by queries that failed too many times
+    mutable std::atomic<int> waiting_ = 0; // Queries waiting for `writer_`, which updates let go first
+
+    /**
+     * Queries the nodes once, without checking that they are consistent.
+     */
+    T QueryNodes(int left, int right) const;
+
+    /**
+     * Updates a leaf and recomputes its ancestors. Must be called inside a write.
+     */
+    void UpdateNodes(int pos, const U& value);
+
+    /**
+     * Start and end of a write: wait for the queries waiting for the mutex, lock it and make the
+     * sequence odd, then make it even again and unlock the mutex.
+     */
+    void BeginWrite();
+    void EndWrite();
+
+    /**
+     * Loads and stores of a node. Acquire loads and release stores order the node accesses
+     * with the sequence, and compile to plain loads and stores on x86.
+     */
+    T Load(int pos) const;
+    void Store(int pos, const T& value);
+};
+
+// Include the implementation file for templates
+#include "ConcurrentSegmentTree.cpp"
+
+#endif // CONCURRENTSEGMENTTREE_HPP
@@ -3,17 +3,17 @@
 
 #include "DisjointSetUnion.hpp"
 
-DisjointSetUnion::DisjointSetUnion(int n) 
+inline DisjointSetUnion::DisjointSetUnion(int n) 
     : n(n), 
       set_count(n), 
       dsu(n, -1) {}
 
-int DisjointSetUnion::root(int x) {
+inline int DisjointSetUnion::root(int x) {
     // Path compression: make parent of x point directly to root
     return dsu[x] < 0 ? x : (dsu[x] = root(dsu[x]));
 }
 
-void DisjointSetUnion::join(int x, int y) {
+inline void DisjointSetUnion::join(int x, int y) {
     x = root(x);
     y = root(y);
     
@@ -30,15 +30,15 @@ void DisjointSetUnion::join(int x, int y) {
     set_count--;       // Decrease set count
 }
 
-bool DisjointSetUnion::query(int x, int y) {
+inline bool DisjointSetUnion::query(int x, int y) {
     return root(x) == root(y);
 }
 
-int DisjointSetUnion::size(int x) {
+inline int DisjointSetUnion::size(int x) {
     return -dsu[root(x)];  // Size stored as negative number
 }
 
-int DisjointSetUnion::count() const {
+inline int DisjointSetUnion::count() const {
     return set_count;
 }
 
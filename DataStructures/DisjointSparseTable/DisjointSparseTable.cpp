@@ -8,52 +8,79 @@ template <typename T, auto op>
 template <Iterator Iter>
 DisjointSparseTable<T, op>::DisjointSparseTable(Iter start, Iter end)
     : size_(std::distance(start, end)),
-      data_(33 - __builtin_clz(size_), std::vector<T>(size_)) {
-    // Copy the input elements into the first layer of the disjoint sparse table
-    std::copy(start, end, data_[0].begin());
+      layers_(size_ > 1 ? 32 - __builtin_clz(size_ - 1) : 1),
+      data_(static_cast<std::size_t>(layers_) * size_) {
+    // The first layer holds the input elements themselves
+    std::copy(start, end, data_.begin());
+    const T* values = data_.data();
 
-    int layer = 0, h = 1; // h is the current block size
-    while (h < size_) {
-        int left = 0, right = std::min(h, size_) - 1;
+    // Layer k splits the array into blocks of h = 2^k elements. Around every boundary `middle` between
+    // an even and an odd block, it stores the suffixes of the left block and the prefixes of the right one
+    for (int layer = 1; layer < layers_; ++layer) {
+        int h = 1 << layer;
+        T* row = data_.data() + static_cast<std::size_t>(layer) * size_;
 
-        // Process each block in the current layer
-        while (left < size_) {
+        for (int middle = h; middle < size_; middle += 2 * h) {
             // Propagate values to the left within the block
-            for (int x = right - 1; x >= left; --x) {
-                data_[layer][x] = op(data_[layer][x], data_[layer][x + 1]);
+            row[middle - 1] = values[middle - 1];
+            for (int x = middle - 2; x >= middle - h; --x) {
+                row[x] = op(values[x], row[x + 1]);
             }
 
-            left += h;
-            right = std::min(right + h, size_ - 1);
-
-            if (left >= size_) break;
-
             // Propagate values to the right within the block
-            for (int x = left + 1; x <= right; ++x) {
-                data_[layer][x] = op(data_[layer][x - 1], data_[layer][x]);
+            row[middle] = values[middle];
+            for (int x = middle + 1; x < std::min(middle + h, size_); ++x) {
+                row[x] = op(row[x - 1], values[x]);
             }
-
-            left += h;
-            right = std::min(right + h, size_ - 1);
         }
-
-        h *= 2; // Double the block size
-        ++layer; // Move to the next layer
     }
 }
 
 // Query function
 template <typename T, auto op>
-T DisjointSparseTable<T, op>::Query(int left, int right) {
+T DisjointSparseTable<T, op>::Query(int left, int right) const {
 
     if (left == right) {
         // Single-element query
-        return data_[0][left];
+        return Data()[left];
     }
 
     // Find the highest differing bit between left and right
     int layer = 31 - __builtin_clz(left ^ right);
-    return op(data_[layer][left], data_[layer][right]);
+    const T* row = Data() + static_cast<std::size_t>(layer) * size_;
+    return op(row[left], row[right]);
+}
+
+// Save to a file
+template <typename T, auto op>
+void DisjointSparseTable<T, op>::SaveTo(const std::string& path) const requires std::is_trivially_copyable_v<T> {
+    Snapshot::Save(path, Snapshot::KIND_DISJOINT_SPARSE_TABLE, {static_cast<std::uint64_t>(size_)},
+                   {{Data(), static_cast<std::uint64_t>(layers_) * size_, sizeof(T)}});
+}
+
+// Map from a file
+template <typename T, auto op>
+DisjointSparseTable<T, op> DisjointSparseTable<T, op>::MapFrom(const std::string& path) requires std::is_trivially_copyable_v<T> {
+    return DisjointSparseTable(Snapshot::Map(path, Snapshot::KIND_DISJOINT_SPARSE_TABLE));
+}
+
+// Constructor over a mapped snapshot
+template <typename T, auto op>
+DisjointSparseTable<T, op>::DisjointSparseTable(Snapshot snapshot)
+    : size_(static_cast<int>(snapshot.Field(0))),
+      layers_(size_ > 1 ? 32 - __builtin_clz(size_ - 1) : 1),
+      snapshot_(std::move(snapshot)) {
+    std::span<const T> layers = snapshot_.Data<T>(0);
+    if (layers.size() != static_cast<std::size_t>(layers_) * size_) {
+        throw std::runtime_error("DisjointSparseTable: the snapshot doesn't hold all the layers");
+    }
+    mapped_ = layers.data();
+}
+
+// Built or mapped layers
+template <typename T, auto op>
+const T* DisjointSparseTable<T, op>::Data() const {
+    return mapped_ != nullptr ? mapped_ : data_.data();
 }
 
 #endif // DISJOINTSPARSETABLE_CPP
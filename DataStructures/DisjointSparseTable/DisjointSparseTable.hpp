@@ -4,7 +4,11 @@
 #include <algorithm>  // For std::copy
 #include <cassert>    // For assert
 #include <functional> // For std::invoke
+#include <string>     // For std::string
+#include <type_traits> // For std::is_trivially_copyable_v
+#include <utility>    // For std::move
 #include <vector>     // For std::vector
+#include "../../Utilities/Snapshot/Snapshot.hpp"
 
 // Concept to ensure the type is an iterator
 template <typename Iter>
@@ -43,16 +47,52 @@ public:
 
     /**
      * Queries the range [left, right].
+     * Read only, so any number of threads can query the same table at once.
      *
      * @param left The left index (inclusive).
      * @param right The right index (inclusive).
      * @return The result of the operation over the range.
      */
-    T Query(int left, int right);
+    T Query(int left, int right) const;
+
+    /**
+     * Saves the table to a file, to be mapped later with MapFrom.
+     *
+     * @param path The path of the file, replaced if it exists.
+     * @throws std::runtime_error if the file can't be written.
+     */
+    void SaveTo(const std::string& path) const requires std::is_trivially_copyable_v<T>;
+
+    /**
+     * Maps a table saved with SaveTo in memory. It is queried in place: nothing is rebuilt or copied,
+     * and processes mapping the same file share its pages.
+     *
+     * @param path The path of the file.
+     * @return The table, which keeps the file mapped as long as it (or a copy of it) exists.
+     * @throws std::runtime_error if the file isn't a DisjointSparseTable snapshot with elements of the size of T.
+     */
+    static DisjointSparseTable MapFrom(const std::string& path) requires std::is_trivially_copyable_v<T>;
 
 private:
     int size_;                  // Number of elements in the table
-    std::vector<std::vector<T>> data_; // The underlying disjoint sparse table data
+    int layers_;                // Number of layers in the table
+    std::vector<T> data_;       // All layers stored back to back, layer k starts at k * size_
+    Snapshot snapshot_;         // The mapped file, if the table was mapped instead of built
+    const T* mapped_ = nullptr; // The layers in the mapped file (data_ is empty then)
+
+    /**
+     * Constructs a DisjointSparseTable over the layers of a mapped snapshot.
+     *
+     * @param snapshot The mapped snapshot.
+     */
+    explicit DisjointSparseTable(Snapshot snapshot);
+
+    /**
+     * Gets the layers, whether they were built or mapped.
+     *
+     * @return The first entry of the first layer.
+     */
+    const T* Data() const;
 };
 
 // Include the implementation file for templates
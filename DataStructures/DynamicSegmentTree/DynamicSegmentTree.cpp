@@ -3,95 +3,300 @@
 
 #include "DynamicSegmentTree.hpp"
 
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-DynamicSegmentTree<T, U, op, updVal, updLazy>::DynamicSegmentTree(
-    ll start, ll end, T identityOp, U identityUpdate)
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::DynamicSegmentTree(
+    ll start, ll end, T identityOp, U identityUpdate, std::size_t capacity)
     : start_(start),
       end_(end),
-      middle_((start + end) / 2),
       identityOp_(identityOp),
       identityUpdate_(identityUpdate),
-      value_(identityOp),
-      lazy_(identityUpdate),
-      left_(nullptr),
-      right_(nullptr) {}
-
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-DynamicSegmentTree<T, U, op, updVal, updLazy>::~DynamicSegmentTree() {
-    Clear();
+      used_(0) {
+    nodes_.reserve(std::max<std::size_t>(capacity, 1));
+    Allocate();
 }
 
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-T DynamicSegmentTree<T, U, op, updVal, updLazy>::Query(ll left, ll right) {
-    // Query range doesn't overlap with node range
-    if (right < start_ || end_ < left) {
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+T DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Query(ll left, ll right) const {
+    stats_.CountQuery();
+    left = std::max(left, start_), right = std::min(right, end_);
+    if (left > right) {
         return identityOp_;
     }
-    
-    // Current node completely contained in query range
-    if (left <= start_ && end_ <= right) {
-        return value_;
+
+    // `pending` holds the lazy updates of the ancestors that have not been pushed down yet
+    index node = 0;
+    ll start = start_, end = end_, middle;
+    U pending = identityUpdate_;
+
+    // Walk down while the query range lies entirely within one child
+    while (true) {
+        const Node& cur = nodes_[node];
+        stats_.CountNodes();
+        if (left <= start && end <= right) {
+            return Apply(cur.value, cur.lazy, pending, start, end);
+        }
+
+        // Missing children: every element below is the identity with the pending updates applied
+        pending = Compose(cur.lazy, pending, start, end);
+        if (cur.left == 0) {
+            return Apply(identityOp_, identityUpdate_, pending, left, right);
+        }
+
+        middle = start + (end - start) / 2;
+        if (right <= middle) {
+            node = cur.left, end = middle;
+        } else if (left > middle) {
+            node = cur.left + 1, start = middle + 1;
+        } else {
+            break;
+        }
+    }
+
+    T left_result = identityOp_, right_result = identityOp_;
+    index split = nodes_[node].left;
+    ll split_end = end;
+    U split_pending = pending;
+
+    // Walk the left boundary: everything to the right of it is covered by the query
+    node = split, end = middle;
+    while (true) {
+        const Node& cur = nodes_[node];
+        stats_.CountNodes();
+        if (left <= start) {
+            left_result = op(Apply(cur.value, cur.lazy, pending, start, end), left_result);
+            stats_.CountOps();
+            break;
+        }
+
+        pending = Compose(cur.lazy, pending, start, end);
+        if (cur.left == 0) {
+            left_result = op(Apply(identityOp_, identityUpdate_, pending, left, end), left_result);
+            stats_.CountOps();
+            break;
+        }
+
+        ll mid = start + (end - start) / 2;
+        if (left > mid) {
+            node = cur.left + 1, start = mid + 1;
+        } else {
+            const Node& sibling = nodes_[cur.left + 1];
+            stats_.CountNodes();
+            left_result = op(Apply(sibling.value, sibling.lazy, pending, mid + 1, end), left_result);
+            stats_.CountOps();
+            node = cur.left, end = mid;
+        }
     }
-    
-    // Propagate updates and query children
-    Propagate();
-    return op(left_->Query(left, right), right_->Query(left, right));
+
+    // Walk the right boundary: everything to the left of it is covered by the query
+    node = split + 1, start = middle + 1, end = split_end, pending = split_pending;
+    while (true) {
+        const Node& cur = nodes_[node];
+        stats_.CountNodes();
+        if (end <= right) {
+            right_result = op(right_result, Apply(cur.value, cur.lazy, pending, start, end));
+            stats_.CountOps();
+            break;
+        }
+
+        pending = Compose(cur.lazy, pending, start, end);
+        if (cur.left == 0) {
+            right_result = op(right_result, Apply(identityOp_, identityUpdate_, pending, start, right));
+            stats_.CountOps();
+            break;
+        }
+
+        ll mid = start + (end - start) / 2;
+        if (right <= mid) {
+            node = cur.left, end = mid;
+        } else {
+            const Node& sibling = nodes_[cur.left];
+            stats_.CountNodes();
+            right_result = op(right_result, Apply(sibling.value, sibling.lazy, pending, start, mid));
+            stats_.CountOps();
+            node = cur.left + 1, start = mid + 1;
+        }
+    }
+
+    stats_.CountOps();
+    return op(left_result, right_result);
 }
 
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-void DynamicSegmentTree<T, U, op, updVal, updLazy>::Update(ll left, ll right, U value) {
-    // Update range doesn't overlap with node range
-    if (right < start_ || end_ < left) {
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Update(ll left, ll right, U value) {
+    stats_.CountUpdate();
+    left = std::max(left, start_), right = std::min(right, end_);
+    if (left > right) {
         return;
     }
-    
-    // Current node completely contained in update range
-    if (left <= start_ && end_ <= right) {
-        updLazy(lazy_, value_, value, start_, end_);
-        return;
+
+    // Nodes whose value has to be recomputed, in top-down order
+    std::array<index, 2 * MAX_DEPTH> path;
+    int top = 0;
+
+    index node = 0;
+    ll start = start_, end = end_, middle;
+
+    // Walk down while the update range lies entirely within one child
+    while (true) {
+        if (left <= start && end <= right) {
+            Tag(node, start, end, value);
+            break;
+        }
+
+        Propagate(node, start, end);
+        path[top++] = node;
+
+        index child = nodes_[node].left;
+        middle = start + (end - start) / 2;
+        if (right <= middle) {
+            node = child, end = middle;
+            continue;
+        }
+        if (left > middle) {
+            node = child + 1, start = middle + 1;
+            continue;
+        }
+
+        // Walk the left boundary: everything to the right of it is covered by the update
+        ll split_end = end;
+        node = child, end = middle;
+        while (left > start) {
+            Propagate(node, start, end);
+            path[top++] = node;
+
+            index next = nodes_[node].left;
+            ll mid = start + (end - start) / 2;
+            if (left > mid) {
+                node = next + 1, start = mid + 1;
+            } else {
+                Tag(next + 1, mid + 1, end, value);
+                node = next, end = mid;
+            }
+        }
+        Tag(node, start, end, value);
+
+        // Walk the right boundary: everything to the left of it is covered by the update
+        node = child + 1, start = middle + 1, end = split_end;
+        while (end > right) {
+            Propagate(node, start, end);
+            path[top++] = node;
+
+            index next = nodes_[node].left;
+            ll mid = start + (end - start) / 2;
+            if (right <= mid) {
+                node = next, end = mid;
+            } else {
+                Tag(next, start, mid, value);
+                node = next + 1, start = mid + 1;
+            }
+        }
+        Tag(node, start, end, value);
+        break;
     }
-    
-    // Propagate updates and update children
-    Propagate();
-    left_->Update(left, right, value);
-    right_->Update(left, right, value);
-    value_ = op(left_->value_, right_->value_);
+
+    // Recompute the touched nodes bottom-up (children always come after their parent in `path`)
+    while (top > 0) {
+        Node& cur = nodes_[path[--top]];
+        cur.value = op(nodes_[cur.left].value, nodes_[cur.left + 1].value);
+        stats_.CountNodes();
+        stats_.CountOps();
+    }
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Reserve(std::size_t capacity) {
+    nodes_.reserve(capacity);
 }
 
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-void DynamicSegmentTree<T, U, op, updVal, updLazy>::Propagate() {
-    // Create children if they don't exist
-    if (left_ == nullptr) {
-        left_ = new DynamicSegmentTree(start_, middle_, identityOp_, identityUpdate_);
-        right_ = new DynamicSegmentTree(middle_ + 1, end_, identityOp_, identityUpdate_);
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Clear() {
+    // Drop every node but the root; stale entries are overwritten on reuse
+    used_ = 1;
+    nodes_[0] = Node{identityOp_, identityUpdate_, 0};
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+OperationStats DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Stats() const {
+    return stats_.Get();
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::ResetStats() {
+    stats_.Reset();
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+typename DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::index
+DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Allocate() {
+    Node node{identityOp_, identityUpdate_, 0};
+    if (used_ == nodes_.size()) {
+        nodes_.push_back(node);
+    } else {
+        nodes_[used_] = node;
     }
-    
-    // Skip if no pending updates
-    if (lazy_ == identityUpdate_) {
-        return;
+    return used_++;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+U DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Compose(
+    U older, const U& newer, ll start, ll end) const {
+    if (newer == identityUpdate_) {
+        return older;
     }
-    
-    // Apply lazy updates to children
-    updLazy(left_->lazy_, left_->value_, lazy_, left_->start_, left_->end_);
-    updLazy(right_->lazy_, right_->value_, lazy_, right_->start_, right_->end_);
-    
-    // Clear pending update
-    lazy_ = identityUpdate_;
+    if (older == identityUpdate_) {
+        return newer;
+    }
+
+    // updLazy also updates a value, so give it a scratch one
+    T scratch = identityOp_;
+    updLazy(older, scratch, newer, start, end);
+    return older;
 }
 
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-void DynamicSegmentTree<T, U, op, updVal, updLazy>::Clear() {
-    if (left_) {
-        left_->Clear();
-        delete left_;
-        left_ = nullptr;
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+T DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Apply(
+    T value, U lazy, const U& pending, ll start, ll end) const {
+    if (pending == identityUpdate_) {
+        return value;
     }
-    
-    if (right_) {
-        right_->Clear();
-        delete right_;
-        right_ = nullptr;
+    updLazy(lazy, value, pending, start, end);
+    return value;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Tag(index node, ll start, ll end, const U& value) {
+    updLazy(nodes_[node].lazy, nodes_[node].value, value, start, end);
+    stats_.CountNodes();
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void DynamicSegmentTree<T, U, op, updVal, updLazy, StatsPolicy>::Propagate(index node, ll start, ll end) {
+    // Create children if they don't exist (always allocated as a pair)
+    if (nodes_[node].left == 0) {
+        index child = Allocate();
+        Allocate();
+        nodes_[node].left = child;
+        stats_.CountAllocation();
+        stats_.CountAllocation();
     }
+
+    Node& cur = nodes_[node];
+
+    // Skip if no pending updates
+    if (cur.lazy == identityUpdate_) {
+        return;
+    }
+
+    // Apply lazy updates to children
+    stats_.CountPropagation();
+    Node& left = nodes_[cur.left];
+    Node& right = nodes_[cur.left + 1];
+    ll middle = start + (end - start) / 2, middle_right = middle + 1;
+    updLazy(left.lazy, left.value, cur.lazy, start, middle);
+    updLazy(right.lazy, right.value, cur.lazy, middle_right, end);
+
+    // Clear pending update
+    cur.lazy = identityUpdate_;
 }
 
 #endif // DYNAMICSEGMENTTREE_CPP
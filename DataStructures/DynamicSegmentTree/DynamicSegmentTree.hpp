@@ -2,7 +2,11 @@
 #define DYNAMICSEGMENTTREE_HPP
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <vector>
+#include "../../Utilities/Stats/Stats.hpp"
 
 /**
  * Dynamic Segment Tree implementation with lazy propagation.
@@ -11,15 +15,18 @@
  * Features:
  * - Handles large ranges efficiently (only creates nodes as needed)
  * - Supports range updates and range queries in O(log N) time
- * - Includes self-cleaning destructor to prevent memory leaks
+ * - Query and Update walk the tree iteratively; Query never allocates nodes
+ * - Nodes live in a single pool addressed by 32-bit indices, so there is
+ *   no per-node heap allocation and the whole tree is reset or freed in O(1)
  *
  * @tparam T The type of values stored in the tree
  * @tparam U The type of lazy update values
  * @tparam op The associative operation function (e.g., sum, min, max)
  * @tparam updVal Function to update a value with a lazy update
  * @tparam updLazy Function to combine lazy updates (takes node range into account)
+ * @tparam StatsPolicy NoStats, or CountStats to count the work of queries and updates (see Stats())
  */
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy = NoStats>
 class DynamicSegmentTree {
     using ll = long long;
 
@@ -51,21 +58,17 @@ public:
      * @param end Last index in range
      * @param identityOp Identity element for the operation
      * @param identityUpdate Identity element for lazy updates
+     * @param capacity Number of nodes to reserve up front (optional)
      */
-    DynamicSegmentTree(ll start, ll end, T identityOp, U identityUpdate);
+    DynamicSegmentTree(ll start, ll end, T identityOp, U identityUpdate, std::size_t capacity = 0);
 
     /**
-     * Destructor - automatically cleans up all allocated nodes
-     */
-    ~DynamicSegmentTree();
-
-    /**
-     * Range query operation
+     * Range query operation (read-only, never creates nodes)
      * @param left Start of query range (inclusive)
      * @param right End of query range (inclusive)
      * @return Result of applying operation over [left, right]
      */
-    T Query(ll left, ll right);
+    T Query(ll left, ll right) const;
 
     /**
      * Range update operation
@@ -75,27 +78,91 @@ public:
      */
     void Update(ll left, ll right, U value);
 
+    /**
+     * Reserves space in the node pool so that no reallocation happens
+     * until more than `capacity` nodes are in use
+     * @param capacity Number of nodes to reserve
+     */
+    void Reserve(std::size_t capacity);
+
+    /**
+     * Resets every element back to the identity in O(1).
+     * The pool keeps its capacity, so the tree can be refilled without reallocating.
+     */
+    void Clear();
+
+    /**
+     * Gets the work done by queries and updates since construction or the last ResetStats().
+     * Always zero with NoStats
+     * @return The counters
+     */
+    OperationStats Stats() const;
+
+    /**
+     * Resets the counters returned by Stats()
+     */
+    void ResetStats();
+
 private:
-    // Node data
-    ll start_;          // Start of range covered by this node
-    ll end_;            // End of range covered by this node
-    ll middle_;         // Midpoint (start + end)/2
-    T identityOp_;      // Identity element for the operation
-    U identityUpdate_;  // Identity element for lazy updates
-    T value_;           // Current node value
-    U lazy_;            // Pending lazy update
-    DynamicSegmentTree* left_;   // Left child
-    DynamicSegmentTree* right_;  // Right child
+    using index = std::uint32_t;
+
+    // A node only stores its payload; the range it covers is derived while descending
+    struct Node {
+        T value;      // Current node value
+        U lazy;       // Pending lazy update
+        index left;   // Index of the left child (right child is left + 1), 0 if absent
+    };
+
+    ll start_;                // Start of range covered by the tree
+    ll end_;                  // End of range covered by the tree
+    T identityOp_;            // Identity element for the operation
+    U identityUpdate_;        // Identity element for lazy updates
+    index used_;              // Number of pool entries currently in use
+    std::vector<Node> nodes_; // Node pool, the root is always nodes_[0]
+    [[no_unique_address]] StatsPolicy stats_; // Counters of the queries and updates (empty with NoStats)
 
     /**
-     * Propagates pending lazy updates to children
+     * Hands out a fresh node from the pool
+     * @return Index of the new node
+     */
+    index Allocate();
+
+    // A range of length up to 2^64 is split at most 64 times on the way to a leaf
+    static constexpr int MAX_DEPTH = 64;
+
+    /**
+     * Composes two lazy updates without touching the tree
+     * @param older Update applied first
+     * @param newer Update applied on top of `older`
+     * @param start Start of range the updates are applied to
+     * @param end End of range the updates are applied to
+     * @return The combined update
      */
-    void Propagate();
+    U Compose(U older, const U& newer, ll start, ll end) const;
 
     /**
-     * Recursively deletes all child nodes
+     * Computes the value of a range after a pending update is applied to it
+     * @param value Current value of the range
+     * @param lazy Lazy update already stored for the range
+     * @param pending Update that has not reached the range yet
+     * @param start Start of the range
+     * @param end End of the range
+     * @return The updated value
      */
-    void Clear();
+    T Apply(T value, U lazy, const U& pending, ll start, ll end) const;
+
+    /**
+     * Applies an update to the node at index `node`, which covers [start, end]
+     */
+    void Tag(index node, ll start, ll end, const U& value);
+
+    /**
+     * Propagates pending lazy updates to children
+     * @param node Index of the node to propagate from
+     * @param start Start of range covered by the node
+     * @param end End of range covered by the node
+     */
+    void Propagate(index node, ll start, ll end);
 };
 
 #include "DynamicSegmentTree.cpp"
@@ -7,22 +7,67 @@
 template <HasOp T>
 template <Iterator Iter>
 FenwickTree<T>::FenwickTree(Iter start, Iter end, T identity)
-    : size_(std::distance(start, end) + 1), identity_(identity), data_(size_, identity) {
-    int index = 1;
-    for (auto it = start; it != end; ++it) {
-        data_[index] += *it; // Add the current element to the tree
+    : identity_(identity) {
+    Assign(start, end);
+}
+
+// Constructor with a given size and identity element
+template <HasOp T>
+FenwickTree<T>::FenwickTree(int size, T identity)
+    : size_(size + 1), identity_(identity), data_(size_, identity) {}
+
+// Rebuild from a range of elements
+template <HasOp T>
+template <Iterator Iter>
+void FenwickTree<T>::Assign(Iter start, Iter end) {
+    // Copy the elements once, then build in place: every node adds its final value to its parent
+    data_.clear();
+    data_.reserve(std::distance(start, end) + 1);
+    data_.push_back(identity_);
+    data_.insert(data_.end(), start, end);
+    size_ = static_cast<int>(data_.size());
+
+    for (int index = 1; index < size_; ++index) {
         int next_block = index + least_significant_bit(index); // Move to the next block
         if (next_block < size_) {
             data_[next_block] += data_[index]; // Propagate the update
         }
-        ++index;
     }
 }
 
-// Constructor with a given size and identity element
+// Batch update function
 template <HasOp T>
-FenwickTree<T>::FenwickTree(int size, T identity)
-    : size_(size + 1), identity_(identity), data_(size_, identity) {}
+void FenwickTree<T>::UpdateBatch(std::span<const std::pair<int, T>> updates) {
+    if (static_cast<long long>(updates.size()) * BATCH_UPDATE_RATIO < size_) {
+        for (const auto& [pos, value] : updates) {
+            Update(pos, value);
+        }
+        return;
+    }
+
+    // Group the updates by position (a counting sort, merging repeated positions)
+    std::vector<T> added(size_, identity_);
+    for (const auto& [pos, value] : updates) {
+        added[pos + 1] += value;
+    }
+
+    // Node i covers (i - lsb(i), i], so it gains prefix(i) - prefix(i - lsb(i)), where prefix is the
+    // running sum of the updates. saved[b] is the prefix at the last index that is a multiple of 2^(b + 1),
+    // which is exactly i - lsb(i) for the nodes with b trailing zeros
+    std::array<T, 32> saved;
+    saved.fill(identity_);
+    T prefix = identity_;
+    for (int index = 1; index < size_; ++index) {
+        prefix += added[index];
+
+        int low = std::countr_zero(static_cast<unsigned>(index));
+        data_[index] += prefix;
+        data_[index] -= saved[low];
+        for (int b = 0; b < low; ++b) {
+            saved[b] = prefix;
+        }
+    }
+}
 
 // Query function
 template <HasOp T>
@@ -40,6 +85,20 @@ void FenwickTree<T>::Update(int pos, T value) {
     }
 }
 
+// Lower bound on prefix sums
+template <HasOp T>
+int FenwickTree<T>::LowerBound(T target) const requires std::totally_ordered<T> {
+    // Grow the prefix [1, pos] by decreasing powers of two while its sum stays below the target
+    int pos = 0;
+    for (int step = std::bit_floor(static_cast<unsigned>(size_ - 1)); step > 0; step /= 2) {
+        if (pos + step < size_ && data_[pos + step] < target) {
+            pos += step;
+            target -= data_[pos];
+        }
+    }
+    return pos; // Position pos + 1 in 1-based indexing
+}
+
 // Prefix sum function
 template <HasOp T>
 T FenwickTree<T>::sum(int pos) {
@@ -1,6 +1,11 @@
 #ifndef FENWICKTREE_HPP
 #define FENWICKTREE_HPP
 
+#include <array>      // For std::array
+#include <bit>        // For std::bit_floor, std::countr_zero
+#include <concepts>   // For std::totally_ordered
+#include <span>       // For std::span
+#include <utility>    // For std::pair
 #include <vector>     // For std::vector
 #include <functional> // For std::invoke
 
@@ -44,6 +49,15 @@ public:
      */
     explicit FenwickTree(int size, T identity);
 
+    /**
+     * Rebuilds the tree from a range of elements in O(N), reusing its storage when it is large enough.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     */
+    template <Iterator Iter>
+    void Assign(Iter start, Iter end);
+
     /**
      * Updates the element at the given position.
      *
@@ -52,6 +66,15 @@ public:
      */
     void Update(int pos, T value);
 
+    /**
+     * Applies many point updates at once.
+     * Sparse batches are applied one by one. Dense batches are grouped by position and merged into the tree
+     * in a single O(N) sweep, instead of O(log N) per update.
+     *
+     * @param updates The pairs {pos, value}, applied as Update(pos, value).
+     */
+    void UpdateBatch(std::span<const std::pair<int, T>> updates);
+
     /**
      * Queries the range [left, right).
      *
@@ -61,7 +84,18 @@ public:
      */
     T Query(int left, int right);
 
+    /**
+     * Finds the first position whose prefix sum reaches `target`, descending the tree by powers of two.
+     * All elements must be non-negative, so that prefix sums are non-decreasing.
+     *
+     * @param target The value the prefix sum must reach.
+     * @return The smallest pos such that Query(0, pos + 1) >= target, or N if there is none.
+     */
+    int LowerBound(T target) const requires std::totally_ordered<T>;
+
 private:
+    static constexpr int BATCH_UPDATE_RATIO = 8; // UpdateBatch sweeps the whole tree from N / ratio updates on
+
     int size_;            // Number of elements in the tree + 1 (for 1-based indexing)
     T identity_;          // Identity element for the operation
     std::vector<T> data_; // The underlying data structure
@@ -0,0 +1,100 @@
+#ifndef FENWICKTREEND_CPP
+#define FENWICKTREEND_CPP
+
+#include "FenwickTreeND.hpp"
+
+// Constructor from a range of elements
+template <HasOp T, int D>
+template <Iterator Iter>
+FenwickTreeND<T, D>::FenwickTreeND(Iter start, Iter end, Point dims, T identity)
+    : dims_(dims), identity_(identity), data_(start, end) {
+    int total = InitStrides();
+    assert(static_cast<int>(data_.size()) == total);
+
+    // A D-dimensional tree is a 1D tree along each axis in turn: build them one axis at a time,
+    // every node adding its value to its parent (index i | (i + 1) in 0-based indexing)
+    for (int axis = 0; axis < D; ++axis) {
+        int stride = strides_[axis], size = dims_[axis];
+        for (int index = 0; index < total; ++index) {
+            int coord = index / stride % size;
+            int parent = coord | (coord + 1);
+            if (parent < size) {
+                data_[index + (parent - coord) * stride] += data_[index];
+            }
+        }
+    }
+}
+
+// Constructor with the given dimensions and identity element
+template <HasOp T, int D>
+FenwickTreeND<T, D>::FenwickTreeND(Point dims, T identity)
+    : dims_(dims), identity_(identity) {
+    data_.assign(InitStrides(), identity_);
+}
+
+// Update function
+template <HasOp T, int D>
+void FenwickTreeND<T, D>::Update(const Point& pos, T value) {
+    UpdateAxis<0>(0, pos, value);
+}
+
+// Query function
+template <HasOp T, int D>
+T FenwickTreeND<T, D>::Query(const Point& left, const Point& right) const {
+    for (int axis = 0; axis < D; ++axis) {
+        if (left[axis] >= right[axis]) {
+            return identity_;
+        }
+    }
+
+    // Inclusion-exclusion over the 2^D corners: a corner taking `left` in k dimensions has sign (-1)^k
+    T added = identity_, removed = identity_;
+    for (int mask = 0; mask < (1 << D); ++mask) {
+        Point corner;
+        for (int axis = 0; axis < D; ++axis) {
+            corner[axis] = (mask >> axis & 1) ? left[axis] : right[axis];
+        }
+        PrefixAxis<0>(0, corner, __builtin_popcount(mask) % 2 == 0 ? added : removed);
+    }
+    added -= removed;
+    return added;
+}
+
+// Strides of the row-major layout
+template <HasOp T, int D>
+int FenwickTreeND<T, D>::InitStrides() {
+    int total = 1;
+    for (int axis = D - 1; axis >= 0; --axis) {
+        strides_[axis] = total;
+        total *= dims_[axis];
+    }
+    return total;
+}
+
+// Update along one dimension
+template <HasOp T, int D>
+template <int Axis>
+void FenwickTreeND<T, D>::UpdateAxis(int offset, const Point& pos, const T& value) {
+    for (int i = pos[Axis]; i < dims_[Axis]; i |= i + 1) {
+        if constexpr (Axis + 1 == D) {
+            data_[offset + i] += value;
+        } else {
+            UpdateAxis<Axis + 1>(offset + i * strides_[Axis], pos, value);
+        }
+    }
+}
+
+// Prefix sum along one dimension
+template <HasOp T, int D>
+template <int Axis>
+void FenwickTreeND<T, D>::PrefixAxis(int offset, const Point& corner, T& result) const {
+    for (int i = corner[Axis] - 1; i >= 0; i = (i & (i + 1)) - 1) {
+        if constexpr (Axis + 1 == D) {
+            result += data_[offset + i];
+        } else {
+            PrefixAxis<Axis + 1>(offset + i * strides_[Axis], corner, result);
+        }
+    }
+}
+
+#endif // FENWICKTREEND_CPP
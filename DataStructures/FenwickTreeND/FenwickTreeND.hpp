@@ -0,0 +1,86 @@
+#ifndef FENWICKTREEND_HPP
+#define FENWICKTREEND_HPP
+
+#include <array>      // For std::array
+#include <cassert>    // For assert
+#include <vector>     // For std::vector
+#include "../FenwickTree/FenwickTree.hpp"
+
+/**
+ * D-dimensional Fenwick Tree (Binary Indexed Tree) implementation.
+ * Supports point updates and queries over boxes, stored as one flat array in row-major order.
+ *
+ * @tparam T The type of elements stored in the tree. Must support addition (+) and subtraction (-).
+ * @tparam D The number of dimensions.
+ */
+template <HasOp T, int D>
+class FenwickTreeND {
+    static_assert(D >= 1, "A FenwickTreeND needs at least one dimension");
+
+public:
+    using Point = std::array<int, D>;
+
+    /**
+     * Constructs a FenwickTreeND from a range of elements in row-major order (the last coordinate varies fastest).
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range. The range must hold exactly the product of `dims` elements.
+     * @param dims The size of each dimension.
+     * @param identity The identity element for the operation (e.g., 0 for sum).
+     */
+    template <Iterator Iter>
+    explicit FenwickTreeND(Iter start, Iter end, Point dims, T identity);
+
+    /**
+     * Constructs a FenwickTreeND with the given dimensions and identity element.
+     *
+     * @param dims The size of each dimension.
+     * @param identity The identity element for the operation.
+     */
+    explicit FenwickTreeND(Point dims, T identity);
+
+    /**
+     * Updates the element at the given position.
+     *
+     * @param pos The coordinates of the position to update.
+     * @param value The value to add to the element at `pos`.
+     */
+    void Update(const Point& pos, T value);
+
+    /**
+     * Queries the box [left[0], right[0]) x ... x [left[D - 1], right[D - 1]).
+     *
+     * @param left The lower corner (inclusive).
+     * @param right The upper corner (exclusive).
+     * @return The result of the operation over the box.
+     */
+    T Query(const Point& left, const Point& right) const;
+
+private:
+    Point dims_;          // Size of each dimension
+    Point strides_;       // Distance in `data_` between consecutive coordinates of each dimension
+    T identity_;          // Identity element for the operation
+    std::vector<T> data_; // The underlying data structure, 0-based in every dimension
+
+    /**
+     * Computes the strides of every dimension and the total number of elements.
+     */
+    int InitStrides();
+
+    /**
+     * Adds `value` to every node covering `pos`, for dimensions `Axis` and above.
+     */
+    template <int Axis>
+    void UpdateAxis(int offset, const Point& pos, const T& value);
+
+    /**
+     * Adds to `result` the sum over the box [0, corner), for dimensions `Axis` and above.
+     */
+    template <int Axis>
+    void PrefixAxis(int offset, const Point& corner, T& result) const;
+};
+
+// Include the implementation file for templates
+#include "FenwickTreeND.cpp"
+
+#endif // FENWICKTREEND_HPP
@@ -4,120 +4,298 @@
 #include "LazyPropSegtree.hpp"
 
 // Constructor from a range of elements
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-LazyPropSegtree<T, U, op, updVal, updLazy>::LazyPropSegtree(auto start, auto end, T identityOp, U identityUpdate)
-    : size_(std::distance(start, end)), LOG_(32 - __builtin_clz(size_)), identityOp_(identityOp),
-      identityUpdate_(identityUpdate), tree_(2 * size_), lazy_(size_, identityUpdate_) {
-    std::copy(start, end, tree_.begin() + size_);
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::LazyPropSegtree(auto start, auto end, T identityOp, U identityUpdate)
+    : LazyPropSegtree(start, end, identityOp, identityUpdate, 1) {}
 
-    // Build the tree bottom-up
-    for (int i = size_ - 1; i > 0; --i) {
-        tree_[i] = op(tree_[2 * i], tree_[2 * i + 1]);
+// Constructor from a range of elements with a parallel build
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::LazyPropSegtree(auto start, auto end, T identityOp, U identityUpdate, int threads)
+    : LazyPropSegtree(static_cast<int>(std::distance(start, end)), identityOp, identityUpdate) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Copy elements into the leaf nodes, the padding leaves keep the identity
+    if constexpr (std::random_access_iterator<decltype(start)>) {
+        ParallelFor(0, n_, threads, [&](int i) { tree_[size_ + i] = start[i]; });
+    } else {
+        std::copy(start, end, tree_.begin() + size_);
+    }
+
+    // Build the tree bottom-up, one level at a time: nodes [2^k, 2^(k+1)) only depend on deeper levels
+    for (int level_start = size_ / 2; level_start > 0; level_start /= 2) {
+        ParallelFor(level_start, 2 * level_start, threads,
+                    [&](int i) { tree_[i] = op(tree_[2 * i], tree_[2 * i + 1]); });
     }
 }
 
 // Constructor with a given size and identity elements
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-LazyPropSegtree<T, U, op, updVal, updLazy>::LazyPropSegtree(int size, T identityOp, U identityUpdate)
-    : size_(size), LOG_(31 - __builtin_clz(size_)), identityOp_(identityOp),
-      identityUpdate_(identityUpdate), tree_(2 * size_, identityOp_), lazy_(size_, identityUpdate_) {}
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::LazyPropSegtree(int size, T identityOp, U identityUpdate)
+    : n_(size), size_(std::bit_ceil(static_cast<unsigned>(std::max(size, 1)))), LOG_(std::countr_zero(static_cast<unsigned>(size_))),
+      identityOp_(identityOp), identityUpdate_(identityUpdate), tree_(2 * size_, identityOp_), lazy_(size_, identityUpdate_) {}
 
 // Query function
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-T LazyPropSegtree<T, U, op, updVal, updLazy>::Query(int left, int right) {
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+T LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::Query(int left, int right) {
+    stats_.CountQuery();
+    if (left == right) {
+        return identityOp_;
+    }
     T left_result = identityOp_, right_result = identityOp_;
     left += size_, right += size_;
 
     // Propagate lazy updates
-    Propagate(left);
-    Propagate(right - 1);
+    Propagate(left, right);
 
     // Perform the query
     while (left < right) {
         if (left % 2 == 1) {
             left_result = op(left_result, tree_[left]);
+            CountNode();
             ++left;
         }
         if (right % 2 == 1) {
             --right;
             right_result = op(tree_[right], right_result);
+            CountNode();
         }
         left /= 2, right /= 2;
     }
 
+    stats_.CountOps();
     return op(left_result, right_result);
 }
 
 // Update function
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-void LazyPropSegtree<T, U, op, updVal, updLazy>::Update(int left, int right, U value) {
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::Update(int left, int right, U value) {
+    stats_.CountUpdate();
+    if (left == right) {
+        return;
+    }
     left += size_, right += size_;
-    int _left = left, _right = right;
 
-    // Apply updates to the leaves
-    if (left % 2 == 1) {
-        tree_[left] = updVal(tree_[left], value);
-        ++left;
+    // Older updates above the range must reach the nodes covering it first, so that
+    // updates are applied in order even if they don't commute (e.g., assignments)
+    Propagate(left, right);
+
+    // Apply the update to the nodes covering the range
+    for (int l = left, r = right; l < r; l /= 2, r /= 2) {
+        if (l % 2 == 1) {
+            Apply(l++, value);
+        }
+        if (r % 2 == 1) {
+            Apply(--r, value);
+        }
     }
-    if (right % 2 == 1) {
-        --right;
-        tree_[right] = updVal(tree_[right], value);
+
+    // Recalculate values after updates
+    Recalculate(left, right);
+}
+
+// Binary search for the end of a range
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+template <typename Pred>
+int LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::MaxRight(int left, Pred pred) {
+    assert(pred(identityOp_));
+    stats_.CountQuery();
+    if (left == n_) {
+        return n_;
     }
+    Propagate(left + size_, n_ + size_);
 
-    left /= 2, right /= 2;
+    // Nodes covering [left, n_) from left to right: found at the left end in order,
+    // then at the right end in reverse order
+    std::array<int, 64> nodes, right_nodes;
+    int count = 0, right_count = 0;
+    for (int l = left + size_, r = n_ + size_; l < r; l /= 2, r /= 2) {
+        if (l % 2 == 1) nodes[count++] = l++;
+        if (r % 2 == 1) right_nodes[right_count++] = --r;
+    }
+    while (right_count > 0) {
+        nodes[count++] = right_nodes[--right_count];
+    }
 
-    // Propagate updates up the tree
-    while (left < right) {
-        if (left % 2 == 1) {
-            tree_[left] = updVal(tree_[left], value);
-            lazy_[left] = updLazy(lazy_[left], value);
-            ++left;
+    T result = identityOp_;
+    for (int k = 0; k < count; ++k) {
+        int node = nodes[k];
+        T next = op(result, tree_[node]);
+        CountNode();
+        if (pred(next)) {
+            result = next;
+            continue;
         }
-        if (right % 2 == 1) {
-            --right;
-            tree_[right] = updVal(tree_[right], value);
-            lazy_[right] = updLazy(lazy_[right], value);
+
+        // The answer is in this node: go down, moving right whenever the left child still satisfies pred
+        while (node < size_) {
+            Push(node);
+            node *= 2;
+            next = op(result, tree_[node]);
+            CountNode();
+            if (pred(next)) {
+                result = next;
+                ++node;
+            }
         }
-        left /= 2, right /= 2;
+        return node - size_;
     }
+    return n_;
+}
 
-    // Recalculate values after updates
-    recalculate_after_update(_left);
-    recalculate_after_update(_right - 1);
+// Binary search for the start of a range
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+template <typename Pred>
+int LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::MinLeft(int right, Pred pred) {
+    assert(pred(identityOp_));
+    stats_.CountQuery();
+    if (right == 0) {
+        return 0;
+    }
+    Propagate(size_, right + size_);
+
+    // Nodes covering [0, right) from right to left: found at the right end in order,
+    // then at the left end in reverse order
+    std::array<int, 64> nodes, left_nodes;
+    int count = 0, left_count = 0;
+    for (int l = size_, r = right + size_; l < r; l /= 2, r /= 2) {
+        if (l % 2 == 1) left_nodes[left_count++] = l++;
+        if (r % 2 == 1) nodes[count++] = --r;
+    }
+    while (left_count > 0) {
+        nodes[count++] = left_nodes[--left_count];
+    }
+
+    T result = identityOp_;
+    for (int k = 0; k < count; ++k) {
+        int node = nodes[k];
+        T next = op(tree_[node], result);
+        CountNode();
+        if (pred(next)) {
+            result = next;
+            continue;
+        }
+
+        // The answer is in this node: go down, moving left whenever the right child still satisfies pred
+        while (node < size_) {
+            Push(node);
+            node = 2 * node + 1;
+            next = op(tree_[node], result);
+            CountNode();
+            if (pred(next)) {
+                result = next;
+                --node;
+            }
+        }
+        return node + 1 - size_;
+    }
+    return 0;
+}
+
+// Apply an update to one node
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::Apply(int pos, const U& value) {
+    if constexpr (LENGTH_AWARE) {
+        // A node at depth d covers size_ / 2^d leaves
+        tree_[pos] = updVal(tree_[pos], value, size_ >> (std::bit_width(static_cast<unsigned>(pos)) - 1));
+    } else {
+        tree_[pos] = updVal(tree_[pos], value);
+    }
+    if (pos < size_) {
+        lazy_[pos] = updLazy(lazy_[pos], value);
+    }
+    stats_.CountNodes();
+}
+
+// Push the lazy update of one node to its children
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::Push(int pos) {
+    if (lazy_[pos] == identityUpdate_) {
+        return;
+    }
+    stats_.CountPropagation();
+    Apply(2 * pos, lazy_[pos]);
+    Apply(2 * pos + 1, lazy_[pos]);
+    lazy_[pos] = identityUpdate_;
 }
 
 // Propagate lazy updates
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-void LazyPropSegtree<T, U, op, updVal, updLazy>::Propagate(int pos) {
-    for (int shift = LOG_; shift > 1; --shift) {
-        int i = pos >> shift;
-        if (lazy_[i] != identityUpdate_) {
-            tree_[2 * i] = updVal(tree_[2 * i], lazy_[i]);
-            lazy_[2 * i] = updLazy(lazy_[2 * i], lazy_[i]);
-
-            tree_[2 * i + 1] = updVal(tree_[2 * i + 1], lazy_[i]);
-            lazy_[2 * i + 1] = updLazy(lazy_[2 * i + 1], lazy_[i]);
-
-            lazy_[i] = identityUpdate_;
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::Propagate(int left, int right) {
+    // From the root down: an ancestor only needs a push if the range ends strictly inside it
+    for (int shift = LOG_; shift > 0; --shift) {
+        if (((left >> shift) << shift) != left) {
+            Push(left >> shift);
+        }
+        if (((right >> shift) << shift) != right) {
+            Push((right - 1) >> shift);
         }
     }
+}
 
-    pos /= 2;
-    if (lazy_[pos] != identityUpdate_) {
-        tree_[2 * pos] = updVal(tree_[2 * pos], lazy_[pos]);
-        tree_[2 * pos + 1] = updVal(tree_[2 * pos + 1], lazy_[pos]);
-        lazy_[pos] = identityUpdate_;
+// Recalculate values after updates
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::Recalculate(int left, int right) {
+    // Those ancestors were pushed, so they have no lazy update left: their children are up to date
+    for (int shift = 1; shift <= LOG_; ++shift) {
+        if (((left >> shift) << shift) != left) {
+            int i = left >> shift;
+            tree_[i] = op(tree_[2 * i], tree_[2 * i + 1]);
+            CountNode();
+        }
+        if (((right >> shift) << shift) != right) {
+            int i = (right - 1) >> shift;
+            tree_[i] = op(tree_[2 * i], tree_[2 * i + 1]);
+            CountNode();
+        }
     }
 }
 
-// Recalculate values after updates
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
-void LazyPropSegtree<T, U, op, updVal, updLazy>::recalculate_after_update(int pos) {
-    pos /= 2;
-    while (pos > 0) {
-        tree_[pos] = op(tree_[2 * pos], tree_[2 * pos + 1]);
-        tree_[pos] = updVal(tree_[pos], lazy_[pos]);
-        pos /= 2;
+// Counters of the queries and updates
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+OperationStats LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::Stats() const {
+    return stats_.Get();
+}
+
+// Reset the counters
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::ResetStats() {
+    stats_.Reset();
+}
+
+// Count nodes combined with one call to `op` each
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::CountNode() const {
+    stats_.CountNodes();
+    stats_.CountOps();
+}
+
+// Run body(i) over [begin, end) on several threads
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy>
+template <typename F>
+void LazyPropSegtree<T, U, op, updVal, updLazy, StatsPolicy>::ParallelFor(int begin, int end, int threads, F body) {
+    // Small ranges are not worth starting threads for
+    threads = std::min(threads, (end - begin) / PARALLEL_GRAIN);
+    if (threads <= 1) {
+        for (int i = begin; i < end; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    int chunk = (end - begin + threads - 1) / threads;
+    for (int lo = begin; lo < end; lo += chunk) {
+        int hi = std::min(end, lo + chunk);
+        workers.emplace_back([lo, hi, &body] {
+            for (int i = lo; i < hi; ++i) {
+                body(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
     }
 }
 
@@ -2,21 +2,30 @@
 #define LAZYPROPSEGTREE_HPP
 
 #include <algorithm>  // For std::copy
+#include <array>      // For std::array
+#include <bit>        // For std::bit_ceil, std::bit_width, std::countr_zero
 #include <cassert>    // For assert
 #include <functional> // For std::invoke
+#include <iterator>   // For std::random_access_iterator
+#include <thread>     // For std::thread
+#include <type_traits> // For std::is_invocable_r_v
 #include <vector>     // For std::vector
+#include "../../Utilities/Stats/Stats.hpp"
 
 /**
  * Lazy Propagation Segment Tree implementation.
  * Supports range updates and range queries with customizable operations.
+ * The leaves are padded to a power of two, so that every node covers a contiguous range.
  *
  * @tparam T The type of elements stored in the segment tree.
  * @tparam U The type of the update value.
  * @tparam op The operation function (e.g., sum, min, max).
- * @tparam updVal The function to update a value with a lazy update.
+ * @tparam updVal The function to update a value with a lazy update, optionally taking the
+ *                number of elements covered by the value as a third argument.
  * @tparam updLazy The function to combine two lazy updates.
+ * @tparam StatsPolicy NoStats, or CountStats to count the work of queries and updates (see Stats()).
  */
-template <typename T, typename U, auto op, auto updVal, auto updLazy>
+template <typename T, typename U, auto op, auto updVal, auto updLazy, typename StatsPolicy = NoStats>
 class LazyPropSegtree {
     // Helper to check if a function is callable with A or A&
     template <typename F, typename A>
@@ -30,11 +39,20 @@ class LazyPropSegtree {
         std::is_invocable_r_v<T, F, A, B> || std::is_invocable_r_v<T, F, A&, B> ||
         std::is_invocable_r_v<T, F, A, B&> || std::is_invocable_r_v<T, F, A&, B&>;
 
+    // Helper to check if a function is callable with T, U and a length, or T&, U& and a length
+    template <typename F, typename A, typename B>
+    static constexpr bool IsCallableWithLength =
+        std::is_invocable_r_v<T, F, A, B, int> || std::is_invocable_r_v<T, F, A&, B, int> ||
+        std::is_invocable_r_v<T, F, A, B&, int> || std::is_invocable_r_v<T, F, A&, B&, int>;
+
+    // Whether `updVal` takes the number of elements it updates (e.g., to add to a sum)
+    static constexpr bool LENGTH_AWARE = IsCallableWithLength<decltype(updVal), T, U>;
+
     // Ensure `op`, `updVal`, and `updLazy` are valid
     static_assert(IsCallable1<decltype(op), T>,
                   "`op` must be callable with T or T& as arguments");
-    static_assert(IsCallable2<decltype(updVal), T, U>,
-                  "`updVal` must be callable with T and U or T& and U& as arguments");
+    static_assert(IsCallable2<decltype(updVal), T, U> || LENGTH_AWARE,
+                  "`updVal` must be callable with T and U or T& and U& as arguments, and optionally an int length");
     static_assert(IsCallable1<decltype(updLazy), U>,
                   "`updLazy` must be callable with U or U& as arguments");
 
@@ -49,6 +67,18 @@ public:
      */
     explicit LazyPropSegtree(auto start, auto end, T identityOp, U identityUpdate);
 
+    /**
+     * Constructs a LazyPropSegtree from a range of elements, building it with several threads.
+     * The result is identical to the serial build.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     * @param identityOp The identity element for the operation (e.g., 0 for sum, INF for min).
+     * @param identityUpdate The identity element for the lazy update.
+     * @param threads The number of threads to use (0 for one per hardware thread).
+     */
+    explicit LazyPropSegtree(auto start, auto end, T identityOp, U identityUpdate, int threads);
+
     /**
      * Constructs a LazyPropSegtree with a given size and identity elements.
      *
@@ -76,27 +106,100 @@ public:
      */
     void Update(int left, int right, U value);
 
+    /**
+     * Finds the largest `right` such that pred(Query(left, right)) is true, in a single walk of the tree.
+     * `pred` must be true for the identity, and once false for a range, false for every longer range.
+     *
+     * @param left The left index (inclusive).
+     * @param pred The predicate, called with the aggregate of a range.
+     * @return The largest right in [left, N] such that pred(Query(left, right)) is true.
+     */
+    template <typename Pred>
+    int MaxRight(int left, Pred pred);
+
+    /**
+     * Finds the smallest `left` such that pred(Query(left, right)) is true, in a single walk of the tree.
+     * `pred` must be true for the identity, and once false for a range, false for every longer range.
+     *
+     * @param right The right index (exclusive).
+     * @param pred The predicate, called with the aggregate of a range.
+     * @return The smallest left in [0, right] such that pred(Query(left, right)) is true.
+     */
+    template <typename Pred>
+    int MinLeft(int right, Pred pred);
+
+    /**
+     * Gets the work done by queries and updates since construction or the last ResetStats().
+     * Always zero with NoStats.
+     *
+     * @return The counters.
+     */
+    OperationStats Stats() const;
+
+    /**
+     * Resets the counters returned by Stats().
+     */
+    void ResetStats();
+
 private:
-    int size_;              // Number of elements in the tree
-    int LOG_;               // Log2 of the size (for propagation)
+    static constexpr int PARALLEL_GRAIN = 1 << 14; // Minimum number of nodes per thread in a parallel build
+
+    int n_;                 // Number of elements in the tree
+    int size_;              // Number of leaves: n_ rounded up to a power of two
+    int LOG_;               // Log2 of the number of leaves (the height of the tree)
     T identityOp_;          // Identity element for the operation
     U identityUpdate_;      // Identity element for the lazy update
     std::vector<T> tree_;   // The underlying tree structure
-    std::vector<U> lazy_;   // Lazy propagation values
+    std::vector<U> lazy_;   // Lazy updates not yet applied to the children of each node
+    [[no_unique_address]] StatsPolicy stats_; // Counters of the queries and updates (empty with NoStats)
+
+    /**
+     * Counts a node combined with one call to `op`.
+     */
+    void CountNode() const;
+
+    /**
+     * Applies an update to a node, and records it for its children if it has any.
+     *
+     * @param pos The node to update.
+     * @param value The update to apply.
+     */
+    void Apply(int pos, const U& value);
+
+    /**
+     * Pushes the lazy update of a single node to its children.
+     *
+     * @param pos The node to push from.
+     */
+    void Push(int pos);
+
+    /**
+     * Pushes the lazy updates down the paths from the root to both ends of a range of leaves,
+     * so that the nodes covering the range hold their current values.
+     *
+     * @param left The first leaf (inclusive).
+     * @param right The last leaf (exclusive).
+     */
+    void Propagate(int left, int right);
 
     /**
-     * Propagates lazy updates down the tree.
+     * Recalculates the ancestors of both ends of a range of leaves after an update.
      *
-     * @param pos The position to propagate from.
+     * @param left The first leaf (inclusive).
+     * @param right The last leaf (exclusive).
      */
-    void Propagate(int pos);
+    void Recalculate(int left, int right);
 
     /**
-     * Recalculates the tree values after an update.
+     * Runs body(i) for every i in [begin, end), split into contiguous chunks over several threads.
      *
-     * @param pos The position to start recalculating from.
+     * @param begin The first index.
+     * @param end One past the last index.
+     * @param threads The maximum number of threads to use.
+     * @param body The function to run for each index.
      */
-    void recalculate_after_update(int pos);
+    template <typename F>
+    static void ParallelFor(int begin, int end, int threads, F body);
 };
 
 // Include the implementation file for templates
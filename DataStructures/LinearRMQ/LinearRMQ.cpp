@@ -0,0 +1,81 @@
+#ifndef LINEARRMQ_CPP
+#define LINEARRMQ_CPP
+
+#include "LinearRMQ.hpp"
+
+// Constructor from a range of elements
+template <typename T, auto op>
+template <Iterator Iter>
+LinearRMQ<T, op>::LinearRMQ(Iter start, Iter end)
+    : size_(0), blocks_(Build(start, end)) {}
+
+// Query function
+template <typename T, auto op>
+T LinearRMQ<T, op>::Query(int left, int right) const {
+    --right;
+    int left_block = left / BLOCK, right_block = right / BLOCK;
+    if (left_block == right_block) {
+        return QueryBlock(left, right);
+    }
+
+    // Both partial blocks at the ends, then the full blocks in between
+    T result = op(QueryBlock(left, left_block * BLOCK + BLOCK - 1), QueryBlock(right_block * BLOCK, right));
+    if (left_block + 1 < right_block) {
+        result = op(result, blocks_.Query(left_block + 1, right_block));
+    }
+    return result;
+}
+
+// Read the elements and build the structure in one pass
+template <typename T, auto op>
+template <Iterator Iter>
+SparseTable<T, op> LinearRMQ<T, op>::Build(Iter start, Iter end) {
+    if constexpr (std::forward_iterator<Iter>) {
+        values_.reserve(std::distance(start, end));
+        masks_.reserve(values_.capacity());
+    }
+
+    std::vector<T> block_results;
+    std::uint64_t stack = 0; // Bit j is set if position j of the current block is on the stack
+    for (; start != end; ++start, ++size_) {
+        int offset = size_ % BLOCK, base = size_ - offset;
+        if (offset == 0) {
+            stack = 0;
+        }
+
+        // Pop every element that the new one is at least as good as
+        values_.push_back(*start);
+        const T& value = values_.back();
+        while (stack != 0) {
+            int top = base + 63 - __builtin_clzll(stack);
+            if (!(op(values_[top], value) == value)) {
+                break;
+            }
+            stack ^= std::uint64_t{1} << (top - base);
+        }
+        stack |= std::uint64_t{1} << offset;
+        masks_.push_back(stack);
+
+        // The bottom of the stack is the result of the whole block
+        if (offset == BLOCK - 1) {
+            block_results.push_back(values_[base + __builtin_ctzll(stack)]);
+        }
+    }
+    assert(size_ > 0 && "LinearRMQ needs at least one element");
+
+    // Last partial block
+    if (size_ % BLOCK != 0) {
+        block_results.push_back(values_[size_ - size_ % BLOCK + __builtin_ctzll(stack)]);
+    }
+    return SparseTable<T, op>(block_results.begin(), block_results.end());
+}
+
+// Query within a single block
+template <typename T, auto op>
+T LinearRMQ<T, op>::QueryBlock(int left, int right) const {
+    // The answer is the deepest element of the stack after `right` that is not left of `left`
+    std::uint64_t stack = masks_[right] & (~std::uint64_t{0} << (left % BLOCK));
+    return values_[right - right % BLOCK + __builtin_ctzll(stack)];
+}
+
+#endif // LINEARRMQ_CPP
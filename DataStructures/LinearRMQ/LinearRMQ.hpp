@@ -0,0 +1,83 @@
+#ifndef LINEARRMQ_HPP
+#define LINEARRMQ_HPP
+
+#include <cassert>    // For assert
+#include <cstdint>    // For std::uint64_t
+#include <functional> // For std::invoke
+#include <vector>     // For std::vector
+
+#include "../SparseTable/SparseTable.hpp"
+
+/**
+ * Linear memory range minimum (or maximum) query structure.
+ * The array is split into blocks of 64 elements: a Sparse Table over the block results answers the
+ * middle of a query, and a bitmask of a monotonic stack for every position answers its two ends.
+ * Supports operations that return one of their arguments, like minimum and maximum.
+ *
+ * @tparam T The type of elements stored in the structure.
+ * @tparam op The operation function (e.g., min, max).
+ */
+template <typename T, auto op>
+class LinearRMQ {
+    // Helper to check if `op` is callable with T or T&
+    template <typename F, typename A, typename B>
+    static constexpr bool IsOpCallable =
+        std::is_invocable_r_v<T, F, A, B> || std::is_invocable_r_v<T, F, A&, B> ||
+        std::is_invocable_r_v<T, F, A, B&> || std::is_invocable_r_v<T, F, A&, B&>;
+
+    // Ensure `op` is valid
+    static_assert(IsOpCallable<decltype(op), T, T>,
+                  "`op` must be callable with T or T& as arguments");
+
+public:
+    /**
+     * Constructs a LinearRMQ from a non-empty range of elements, reading it once from start to end.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     */
+    template <Iterator Iter>
+    explicit LinearRMQ(Iter start, Iter end);
+
+    /**
+     * Queries the range [left, right).
+     * Read only, so any number of threads can query the same structure at once.
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @return The result of the operation over the range.
+     */
+    T Query(int left, int right) const;
+
+private:
+    static constexpr int BLOCK = 64; // Number of elements per block, one bit of a mask each
+
+    int size_;                        // Number of elements
+    std::vector<T> values_;           // The elements themselves
+    std::vector<std::uint64_t> masks_; // Positions on the monotonic stack of each block after each element
+    SparseTable<T, op> blocks_;       // Sparse Table over the result of every block
+
+    /**
+     * Reads the elements, fills `values_` and `masks_` and builds the Sparse Table over the blocks.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     * @return The Sparse Table over the result of every block.
+     */
+    template <Iterator Iter>
+    SparseTable<T, op> Build(Iter start, Iter end);
+
+    /**
+     * Queries the range [left, right] where both ends are in the same block.
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (inclusive).
+     * @return The result of the operation over the range.
+     */
+    T QueryBlock(int left, int right) const;
+};
+
+// Include the implementation file for templates
+#include "LinearRMQ.cpp"
+
+#endif // LINEARRMQ_HPP
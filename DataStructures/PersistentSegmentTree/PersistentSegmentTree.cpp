@@ -0,0 +1,255 @@
+#ifndef PERSISTENTSEGMENTTREE_CPP
+#define PERSISTENTSEGMENTTREE_CPP
+
+#include "PersistentSegmentTree.hpp"
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+PersistentSegmentTree<T, U, op, updVal, updLazy>::PersistentSegmentTree(
+    ll start, ll end, T identityOp, U identityUpdate, std::size_t capacity)
+    : start_(start),
+      end_(end),
+      identityOp_(identityOp),
+      identityUpdate_(identityUpdate),
+      used_(1),
+      fresh_(1) {
+    nodes_.reserve(std::max<std::size_t>(capacity, 1));
+    nodes_.push_back(Node{identityOp_, identityUpdate_, 0, 0});
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+template <std::random_access_iterator Iter>
+typename PersistentSegmentTree<T, U, op, updVal, updLazy>::Version
+PersistentSegmentTree<T, U, op, updVal, updLazy>::Build(Iter first, Iter last) {
+    ll count = std::min<ll>(std::distance(first, last), end_ - start_ + 1);
+    return Build(first, count, start_, end_);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+T PersistentSegmentTree<T, U, op, updVal, updLazy>::Query(Version version, ll left, ll right) const {
+    left = std::max(left, start_), right = std::min(right, end_);
+    if (left > right) {
+        return identityOp_;
+    }
+    return Query(version, start_, end_, left, right, identityUpdate_);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+typename PersistentSegmentTree<T, U, op, updVal, updLazy>::Version
+PersistentSegmentTree<T, U, op, updVal, updLazy>::Update(Version version, ll left, ll right, U value) {
+    left = std::max(left, start_), right = std::min(right, end_);
+    if (left > right) {
+        return version;
+    }
+
+    // Nodes created from here on belong only to the new version
+    fresh_ = used_;
+    return Update(version, start_, end_, left, right, value);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+std::vector<typename PersistentSegmentTree<T, U, op, updVal, updLazy>::Version>
+PersistentSegmentTree<T, U, op, updVal, updLazy>::Collect(std::span<const Version> versions) {
+    // Mark the reachable nodes (remap[i] != 0), walking each shared subtree once
+    std::vector<index> remap(used_, 0), stack;
+    for (Version version : versions) {
+        if (version != 0 && remap[version] == 0) {
+            remap[version] = 1;
+            stack.push_back(version);
+        }
+        while (!stack.empty()) {
+            const Node& cur = nodes_[stack.back()];
+            stack.pop_back();
+            for (index child : {cur.left, cur.right}) {
+                if (child != 0 && remap[child] == 0) {
+                    remap[child] = 1;
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+
+    // Number the kept nodes in pool order. A node never moves up, so compacting in that order
+    // only overwrites nodes that were already moved
+    index next = 1;
+    for (index node = 1; node < used_; ++node) {
+        if (remap[node] != 0) {
+            remap[node] = next++;
+        }
+    }
+    for (index node = 1; node < used_; ++node) {
+        if (remap[node] != 0) {
+            Node moved = nodes_[node];
+            moved.left = remap[moved.left];
+            moved.right = remap[moved.right];
+            nodes_[remap[node]] = moved;
+        }
+    }
+    used_ = fresh_ = next;
+
+    std::vector<Version> kept;
+    kept.reserve(versions.size());
+    for (Version version : versions) {
+        kept.push_back(remap[version]);
+    }
+    return kept;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+void PersistentSegmentTree<T, U, op, updVal, updLazy>::Reserve(std::size_t capacity) {
+    nodes_.reserve(capacity);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+void PersistentSegmentTree<T, U, op, updVal, updLazy>::Clear() {
+    // Drop every node but the identity tree; stale entries are overwritten on reuse
+    used_ = fresh_ = 1;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+std::size_t PersistentSegmentTree<T, U, op, updVal, updLazy>::NodeCount() const {
+    return used_;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+typename PersistentSegmentTree<T, U, op, updVal, updLazy>::index
+PersistentSegmentTree<T, U, op, updVal, updLazy>::Allocate(index node) {
+    Node copy = nodes_[node];
+    if (used_ == nodes_.size()) {
+        nodes_.push_back(copy);
+    } else {
+        nodes_[used_] = copy;
+    }
+    return used_++;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+typename PersistentSegmentTree<T, U, op, updVal, updLazy>::index
+PersistentSegmentTree<T, U, op, updVal, updLazy>::Own(index node) {
+    return node >= fresh_ ? node : Allocate(node);
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+template <std::random_access_iterator Iter>
+typename PersistentSegmentTree<T, U, op, updVal, updLazy>::index
+PersistentSegmentTree<T, U, op, updVal, updLazy>::Build(Iter first, ll count, ll start, ll end) {
+    // Missing elements are the identity: share the identity tree
+    if (count == 0) {
+        return 0;
+    }
+
+    index node = Allocate(0);
+    if (start == end) {
+        nodes_[node].value = first[0];
+        return node;
+    }
+
+    // Children are built before they are linked, as allocating may move the pool
+    ll middle = start + (end - start) / 2, left_count = std::min(count, middle - start + 1);
+    index left = Build(first, left_count, start, middle);
+    index right = Build(first + left_count, count - left_count, middle + 1, end);
+    nodes_[node].left = left;
+    nodes_[node].right = right;
+    nodes_[node].value = op(nodes_[left].value, nodes_[right].value);
+    return node;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+T PersistentSegmentTree<T, U, op, updVal, updLazy>::Query(
+    index node, ll start, ll end, ll left, ll right, U pending) const {
+    const Node& cur = nodes_[node];
+    if (left <= start && end <= right) {
+        return Apply(cur.value, cur.lazy, pending, start, end);
+    }
+
+    // Inside the identity tree, every element is the identity with the pending updates applied
+    pending = Compose(cur.lazy, pending, start, end);
+    if (node == 0) {
+        return Apply(identityOp_, identityUpdate_, pending, std::max(left, start), std::min(right, end));
+    }
+
+    ll middle = start + (end - start) / 2;
+    if (right <= middle) {
+        return Query(cur.left, start, middle, left, right, pending);
+    }
+    if (left > middle) {
+        return Query(cur.right, middle + 1, end, left, right, pending);
+    }
+    return op(Query(cur.left, start, middle, left, right, pending),
+              Query(cur.right, middle + 1, end, left, right, pending));
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+typename PersistentSegmentTree<T, U, op, updVal, updLazy>::index
+PersistentSegmentTree<T, U, op, updVal, updLazy>::Update(
+    index node, ll start, ll end, ll left, ll right, const U& value) {
+    node = Own(node);
+    if (left <= start && end <= right) {
+        updLazy(nodes_[node].lazy, nodes_[node].value, value, start, end);
+        return node;
+    }
+
+    // Push first, so that the lazy update of a node stays newer than everything below it
+    Propagate(node, start, end);
+    ll middle = start + (end - start) / 2;
+    if (left <= middle) {
+        index child = Update(nodes_[node].left, start, middle, left, right, value);
+        nodes_[node].left = child;
+    }
+    if (right > middle) {
+        index child = Update(nodes_[node].right, middle + 1, end, left, right, value);
+        nodes_[node].right = child;
+    }
+
+    Node& cur = nodes_[node];
+    cur.value = op(nodes_[cur.left].value, nodes_[cur.right].value);
+    return node;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+U PersistentSegmentTree<T, U, op, updVal, updLazy>::Compose(
+    U older, const U& newer, ll start, ll end) const {
+    if (newer == identityUpdate_) {
+        return older;
+    }
+    if (older == identityUpdate_) {
+        return newer;
+    }
+
+    // updLazy also updates a value, so give it a scratch one
+    T scratch = identityOp_;
+    updLazy(older, scratch, newer, start, end);
+    return older;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+T PersistentSegmentTree<T, U, op, updVal, updLazy>::Apply(
+    T value, U lazy, const U& pending, ll start, ll end) const {
+    if (pending == identityUpdate_) {
+        return value;
+    }
+    updLazy(lazy, value, pending, start, end);
+    return value;
+}
+
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+void PersistentSegmentTree<T, U, op, updVal, updLazy>::Propagate(index node, ll start, ll end) {
+    // Skip if no pending updates
+    if (nodes_[node].lazy == identityUpdate_) {
+        return;
+    }
+
+    // The children may be shared with other versions: apply the update to copies of them
+    U lazy = nodes_[node].lazy;
+    ll middle = start + (end - start) / 2, middle_right = middle + 1;
+    index left = Own(nodes_[node].left);
+    index right = Own(nodes_[node].right);
+    updLazy(nodes_[left].lazy, nodes_[left].value, lazy, start, middle);
+    updLazy(nodes_[right].lazy, nodes_[right].value, lazy, middle_right, end);
+
+    // Clear pending update
+    Node& cur = nodes_[node];
+    cur.left = left, cur.right = right;
+    cur.lazy = identityUpdate_;
+}
+
+#endif // PERSISTENTSEGMENTTREE_CPP
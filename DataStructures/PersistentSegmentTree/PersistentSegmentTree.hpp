@@ -0,0 +1,203 @@
+#ifndef PERSISTENTSEGMENTTREE_HPP
+#define PERSISTENTSEGMENTTREE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <vector>
+
+/**
+ * Persistent Segment Tree implementation with lazy propagation.
+ * Every update leaves the previous versions untouched and returns the root of a new one.
+ *
+ * Features:
+ * - Range updates and range queries in O(log N) time on any version
+ * - Each update copies only the O(log N) nodes it touches, everything else is shared between versions
+ * - Query never allocates nodes, so it costs the same on old versions as on the latest one
+ * - Nodes of all versions live in a single pool addressed by 32-bit indices, and the versions
+ *   that are no longer needed are garbage-collected in bulk with Collect
+ *
+ * @tparam T The type of values stored in the tree
+ * @tparam U The type of lazy update values
+ * @tparam op The associative operation function (e.g., sum, min, max)
+ * @tparam updVal Function to update a value with a lazy update
+ * @tparam updLazy Function to combine lazy updates (takes node range into account)
+ */
+template <typename T, typename U, auto op, auto updVal, auto updLazy>
+class PersistentSegmentTree {
+    using ll = long long;
+
+    // Type trait to check if operation is valid
+    template <typename F, typename A, typename B>
+    static constexpr bool IsBinaryOperation =
+        std::is_invocable_r_v<T, F, A, B> ||
+        std::is_invocable_r_v<T, F, A&, B> ||
+        std::is_invocable_r_v<T, F, A, B&> ||
+        std::is_invocable_r_v<T, F, A&, B&>;
+
+    // Type trait to check if lazy update is valid
+    template <typename F, typename A, typename B, typename C, typename D, typename E>
+    static constexpr bool IsLazyOperation =
+        std::is_invocable_v<F, A&, B&, C, D&, E&>;
+
+    // Compile-time validation of operation signatures
+    static_assert(IsBinaryOperation<decltype(op), T, T>,
+                "Operation must be callable with (T, T) and return T");
+    static_assert(IsBinaryOperation<decltype(updVal), T, U>,
+                "Value update must be callable with (T, U) and return T");
+    static_assert(IsLazyOperation<decltype(updLazy), U, T, U, ll, ll>,
+                "Lazy update must be callable with (U&, T&, U, ll&, ll&)");
+
+public:
+    // A version is identified by the index of its root; version 0 has every element equal to the identity
+    using Version = std::uint32_t;
+
+    /**
+     * Constructs a persistent segment tree covering [start, end]
+     * @param start First index in range
+     * @param end Last index in range
+     * @param identityOp Identity element for the operation
+     * @param identityUpdate Identity element for lazy updates
+     * @param capacity Number of nodes to reserve up front (optional)
+     */
+    PersistentSegmentTree(ll start, ll end, T identityOp, U identityUpdate, std::size_t capacity = 0);
+
+    /**
+     * Builds a version holding the given elements at start, start + 1, ... (the rest is the identity)
+     * @param first Iterator to the first element
+     * @param last Iterator past the last element
+     * @return The new version, using O(last - first) nodes
+     */
+    template <std::random_access_iterator Iter>
+    Version Build(Iter first, Iter last);
+
+    /**
+     * Range query operation on a version (read-only, never creates nodes)
+     * @param version The version to query
+     * @param left Start of query range (inclusive)
+     * @param right End of query range (inclusive)
+     * @return Result of applying operation over [left, right] in `version`
+     */
+    T Query(Version version, ll left, ll right) const;
+
+    /**
+     * Range update operation, leaving `version` unchanged
+     * @param version The version to update
+     * @param left Start of update range (inclusive)
+     * @param right End of update range (inclusive)
+     * @param value Update value to apply
+     * @return The new version
+     */
+    Version Update(Version version, ll left, ll right, U value);
+
+    /**
+     * Frees every node that is not reachable from `versions`, compacting the pool.
+     * All other versions become invalid, and the kept ones are renumbered.
+     * @param versions The versions to keep
+     * @return The new numbers of the kept versions, in the same order
+     */
+    std::vector<Version> Collect(std::span<const Version> versions);
+
+    /**
+     * Reserves space in the node pool so that no reallocation happens
+     * until more than `capacity` nodes are in use
+     * @param capacity Number of nodes to reserve
+     */
+    void Reserve(std::size_t capacity);
+
+    /**
+     * Drops every version in O(1), leaving only version 0.
+     * The pool keeps its capacity, so new versions can be built without reallocating.
+     */
+    void Clear();
+
+    /**
+     * @return The number of nodes in use by all versions
+     */
+    std::size_t NodeCount() const;
+
+private:
+    using index = std::uint32_t;
+
+    // A node only stores its payload; the range it covers is derived while descending
+    struct Node {
+        T value;      // Current node value
+        U lazy;       // Pending lazy update, newer than every update below the node
+        index left;   // Index of the left child
+        index right;  // Index of the right child
+    };
+
+    ll start_;                // Start of range covered by the tree
+    ll end_;                  // End of range covered by the tree
+    T identityOp_;            // Identity element for the operation
+    U identityUpdate_;        // Identity element for lazy updates
+    index used_;              // Number of pool entries currently in use
+    index fresh_;             // First node created by the running update, which it may modify in place
+    std::vector<Node> nodes_; // Node pool. nodes_[0] is an all-identity tree whose children are itself
+
+    /**
+     * Hands out a copy of a node from the pool
+     * @param node Index of the node to copy
+     * @return Index of the new node
+     */
+    index Allocate(index node);
+
+    /**
+     * Returns a node that the running update may modify: `node` itself if it was created
+     * by this update, a copy of it otherwise
+     */
+    index Own(index node);
+
+    /**
+     * Builds the subtree covering [start, end] from `count` elements placed at start, start + 1, ...
+     */
+    template <std::random_access_iterator Iter>
+    index Build(Iter first, ll count, ll start, ll end);
+
+    /**
+     * Recursive query of [left, right] in the subtree of `node`, which covers [start, end]
+     * and has `pending` updates from its ancestors
+     */
+    T Query(index node, ll start, ll end, ll left, ll right, U pending) const;
+
+    /**
+     * Recursive update of [left, right] in the subtree of `node`, which covers [start, end]
+     * @return The index of the updated copy of `node`
+     */
+    index Update(index node, ll start, ll end, ll left, ll right, const U& value);
+
+    /**
+     * Composes two lazy updates without touching the tree
+     * @param older Update applied first
+     * @param newer Update applied on top of `older`
+     * @param start Start of range the updates are applied to
+     * @param end End of range the updates are applied to
+     * @return The combined update
+     */
+    U Compose(U older, const U& newer, ll start, ll end) const;
+
+    /**
+     * Computes the value of a range after a pending update is applied to it
+     * @param value Current value of the range
+     * @param lazy Lazy update already stored for the range
+     * @param pending Update that has not reached the range yet
+     * @param start Start of the range
+     * @param end End of the range
+     * @return The updated value
+     */
+    T Apply(T value, U lazy, const U& pending, ll start, ll end) const;
+
+    /**
+     * Moves the lazy update of an owned node into copies of its children
+     * @param node Index of the node to propagate from
+     * @param start Start of range covered by the node
+     * @param end End of range covered by the node
+     */
+    void Propagate(index node, ll start, ll end);
+};
+
+#include "PersistentSegmentTree.cpp"
+
+#endif // PERSISTENTSEGMENTTREE_HPP
@@ -0,0 +1,77 @@
+#ifndef RANGEFENWICKTREE_CPP
+#define RANGEFENWICKTREE_CPP
+
+#include "RangeFenwickTree.hpp"
+
+// Constructor from a range of elements
+template <HasOp T>
+    requires HasScale<T>
+template <Iterator Iter>
+RangeFenwickTree<T>::RangeFenwickTree(Iter start, Iter end, T identity)
+    : size_(std::distance(start, end)),
+      linear_(Differences(start, end, identity, false)),
+      constant_(Differences(start, end, identity, true)) {}
+
+// Constructor with a given size and identity element
+template <HasOp T>
+    requires HasScale<T>
+RangeFenwickTree<T>::RangeFenwickTree(int size, T identity)
+    : size_(size), linear_(size, identity), constant_(size, identity) {}
+
+// Update function
+template <HasOp T>
+    requires HasScale<T>
+void RangeFenwickTree<T>::Update(int left, int right, T value) {
+    if (left >= right) {
+        return;
+    }
+
+    // d[left] += value, d[right] -= value (nothing to undo past the end)
+    linear_.Update(left, value);
+    constant_.Update(left, value * left);
+    if (right < size_) {
+        T negated = value * -1;
+        linear_.Update(right, negated);
+        constant_.Update(right, value * -right);
+    }
+}
+
+// Query function
+template <HasOp T>
+    requires HasScale<T>
+T RangeFenwickTree<T>::Query(int left, int right) {
+    T result = sum(right);
+    result -= sum(left);
+    return result;
+}
+
+// Tree of (scaled) differences
+template <HasOp T>
+    requires HasScale<T>
+template <Iterator Iter>
+FenwickTree<T> RangeFenwickTree<T>::Differences(Iter start, Iter end, T identity, bool scaled) {
+    std::vector<T> differences;
+    differences.reserve(std::distance(start, end));
+
+    T previous = identity;
+    int index = 0;
+    for (auto it = start; it != end; ++it, ++index) {
+        T difference = *it;
+        difference -= previous;
+        previous = *it;
+        differences.push_back(scaled ? T(difference * index) : difference);
+    }
+    return FenwickTree<T>(differences.begin(), differences.end(), identity);
+}
+
+// Prefix sum function
+template <HasOp T>
+    requires HasScale<T>
+T RangeFenwickTree<T>::sum(int pos) {
+    // sum of a[i] for i < pos = pos * sum of d[i] - sum of d[i] * i, over i < pos
+    T result = linear_.Query(0, pos) * pos;
+    result -= constant_.Query(0, pos);
+    return result;
+}
+
+#endif // RANGEFENWICKTREE_CPP
@@ -0,0 +1,83 @@
+#ifndef RANGEFENWICKTREE_HPP
+#define RANGEFENWICKTREE_HPP
+
+#include <concepts>   // For std::convertible_to
+#include <vector>     // For std::vector
+#include "../FenwickTree/FenwickTree.hpp"
+
+// Concept to ensure T can be multiplied by an index
+template <typename T>
+concept HasScale = requires(T a, int k) {
+    { a * k } -> std::convertible_to<T>;
+};
+
+/**
+ * Fenwick Tree supporting range updates and range queries.
+ * Stores the differences between consecutive elements in two Fenwick Trees (the dual-array technique).
+ *
+ * @tparam T The type of elements stored in the tree. Must support +=, -= and multiplication by an int.
+ */
+template <HasOp T>
+    requires HasScale<T>
+class RangeFenwickTree {
+public:
+    /**
+     * Constructs a RangeFenwickTree from a range of elements.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     * @param identity The identity element for the operation (e.g., 0 for sum).
+     */
+    template <Iterator Iter>
+    explicit RangeFenwickTree(Iter start, Iter end, T identity);
+
+    /**
+     * Constructs a RangeFenwickTree with a given size and identity element.
+     *
+     * @param size The number of elements in the tree.
+     * @param identity The identity element for the operation.
+     */
+    explicit RangeFenwickTree(int size, T identity);
+
+    /**
+     * Adds a value to every element of the range [left, right).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @param value The value to add to each element.
+     */
+    void Update(int left, int right, T value);
+
+    /**
+     * Queries the range [left, right).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @return The result of the operation over the range.
+     */
+    T Query(int left, int right);
+
+private:
+    int size_;                 // Number of elements in the tree
+    FenwickTree<T> linear_;    // Differences d[i] = a[i] - a[i - 1]
+    FenwickTree<T> constant_;  // Differences scaled by their index, d[i] * i
+
+    /**
+     * Builds the tree of differences of a range of elements, scaled by their index if `scaled` is true.
+     */
+    template <Iterator Iter>
+    static FenwickTree<T> Differences(Iter start, Iter end, T identity, bool scaled);
+
+    /**
+     * Computes the sum of the first `pos` elements.
+     *
+     * @param pos The number of elements to sum.
+     * @return The prefix sum.
+     */
+    T sum(int pos);
+};
+
+// Include the implementation file for templates
+#include "RangeFenwickTree.cpp"
+
+#endif // RANGEFENWICKTREE_HPP
@@ -0,0 +1,67 @@
+#ifndef ROLLBACKDISJOINTSETUNION_CPP
+#define ROLLBACKDISJOINTSETUNION_CPP
+
+#include "RollbackDisjointSetUnion.hpp"
+
+inline RollbackDisjointSetUnion::RollbackDisjointSetUnion(int n)
+    : n(n),
+      set_count(n),
+      dsu(n, -1) {}
+
+inline int RollbackDisjointSetUnion::root(int x) const {
+    // No path compression: union by size alone keeps the trees O(log N) deep
+    while (dsu[x] >= 0) {
+        x = dsu[x];
+    }
+    return x;
+}
+
+inline bool RollbackDisjointSetUnion::join(int x, int y) {
+    x = root(x);
+    y = root(y);
+
+    // Already in same set
+    if (x == y) return false;
+
+    // Union by size: smaller tree joins larger tree
+    if (dsu[x] < dsu[y]) {
+        std::swap(x, y);
+    }
+
+    history.emplace_back(x, dsu[x]); // Remember what to undo
+    dsu[y] += dsu[x];  // Update size
+    dsu[x] = y;        // Make x point to y
+    set_count--;       // Decrease set count
+    return true;
+}
+
+inline bool RollbackDisjointSetUnion::query(int x, int y) const {
+    return root(x) == root(y);
+}
+
+inline int RollbackDisjointSetUnion::size(int x) const {
+    return -dsu[root(x)];  // Size stored as negative number
+}
+
+inline int RollbackDisjointSetUnion::count() const {
+    return set_count;
+}
+
+inline int RollbackDisjointSetUnion::snapshot() const {
+    return static_cast<int>(history.size());
+}
+
+inline void RollbackDisjointSetUnion::rollback(int snapshot) {
+    while (static_cast<int>(history.size()) > snapshot) {
+        auto [x, value] = history.back();
+        history.pop_back();
+
+        // x is still linked directly to the root it joined, which holds the merged size
+        int y = dsu[x];
+        dsu[y] -= value;
+        dsu[x] = value;
+        set_count++;
+    }
+}
+
+#endif // ROLLBACKDISJOINTSETUNION_CPP
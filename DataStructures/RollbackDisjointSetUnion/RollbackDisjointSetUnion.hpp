@@ -0,0 +1,77 @@
+#ifndef ROLLBACKDISJOINTSETUNION_HPP
+#define ROLLBACKDISJOINTSETUNION_HPP
+
+#include <utility>  // For std::pair, std::swap
+#include <vector>   // For std::vector
+
+/**
+ * Disjoint Set Union (DSU) data structure with union by size and rollbacks.
+ * There is no path compression, so every join can be undone in O(1).
+ */
+class RollbackDisjointSetUnion {
+public:
+    /**
+     * Constructs a DSU with n elements
+     * @param n Number of elements
+     */
+    explicit RollbackDisjointSetUnion(int n);
+
+    /**
+     * Finds the root of element x
+     * @param x Element to find
+     * @return Root of x
+     */
+    int root(int x) const;
+
+    /**
+     * Joins two sets containing x and y
+     * @param x First element
+     * @param y Second element
+     * @return True if the sets were merged, false if they were already the same
+     */
+    bool join(int x, int y);
+
+    /**
+     * Checks if x and y are in the same set
+     * @param x First element
+     * @param y Second element
+     * @return True if x and y are in the same set
+     */
+    bool query(int x, int y) const;
+
+    /**
+     * Gets the size of the set containing x
+     * @param x Element to check
+     * @return Size of the set containing x
+     */
+    int size(int x) const;
+
+    /**
+     * Gets the total number of sets
+     * @return Number of disjoint sets
+     */
+    int count() const;
+
+    /**
+     * Gets the current state, to be restored later with rollback
+     * @return Number of merges done so far (and not undone)
+     */
+    int snapshot() const;
+
+    /**
+     * Undoes every merge done since the given snapshot, in reverse order
+     * @param snapshot Value returned by snapshot, not greater than the current one
+     */
+    void rollback(int snapshot);
+
+private:
+    int n;                                    // Total number of elements
+    int set_count;                            // Current number of disjoint sets
+    std::vector<int> dsu;                     // Parent/size storage (-size for roots)
+    std::vector<std::pair<int, int>> history; // Root linked by each merge, and its value before it
+};
+
+// Include the implementation file for templates
+#include "RollbackDisjointSetUnion.cpp"
+
+#endif // ROLLBACKDISJOINTSETUNION_HPP
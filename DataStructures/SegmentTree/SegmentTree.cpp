@@ -4,63 +4,682 @@
 #include "SegmentTree.hpp"
 
 // Constructor from a range of elements
-template <typename T, typename U, auto op, auto update>
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
 template <Iterator Iter>
-SegmentTree<T, U, op, update>::SegmentTree(Iter start, Iter end, T identity)
-    : size_(std::distance(start, end)), identity_(identity), tree_(2 * size_) {
+SegmentTree<T, U, op, update, Layout, StatsPolicy>::SegmentTree(Iter start, Iter end, T identity)
+    : SegmentTree(start, end, identity, 1) {}
+
+// Constructor from a range of elements with a parallel build
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <Iterator Iter>
+SegmentTree<T, U, op, update, Layout, StatsPolicy>::SegmentTree(Iter start, Iter end, T identity, int threads)
+    : size_(std::distance(start, end)), identity_(identity), tree_(IS_WIDE ? 0 : 2 * size_) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
     // Copy elements into the leaf nodes
-    std::copy(start, end, tree_.begin() + size_);
+    if constexpr (IS_WIDE) {
+        InitWide();
+    }
+    auto leaves = tree_.begin() + (IS_WIDE ? 0 : size_);
+    if constexpr (std::random_access_iterator<Iter>) {
+        ParallelFor(0, size_, threads, [&](int i) { leaves[i] = start[i]; });
+    } else {
+        std::copy(start, end, leaves);
+    }
+
+    if constexpr (IS_WIDE) {
+        BuildWide(threads);
+        return;
+    }
 
-    // Build the tree bottom-up
-    for (int i = size_ - 1; i > 0; --i) {
-        tree_[i] = op(tree_[2 * i], tree_[2 * i + 1]);
+    // Build the tree bottom-up, one level at a time: nodes [2^k, 2^(k+1)) only depend on deeper levels
+    for (int level_start = std::bit_floor(static_cast<unsigned>(std::max(size_ - 1, 1))); level_start > 0; level_start /= 2) {
+        ParallelFor(level_start, std::min(2 * level_start, size_), threads,
+                    [&](int i) { tree_[i] = op(tree_[2 * i], tree_[2 * i + 1]); });
     }
 }
 
 // Constructor with a given size and identity element
-template <typename T, typename U, auto op, auto update>
-SegmentTree<T, U, op, update>::SegmentTree(int size, T identity)
-    : size_(size), identity_(identity), tree_(2 * size_, identity) {}
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+SegmentTree<T, U, op, update, Layout, StatsPolicy>::SegmentTree(int size, T identity)
+    : size_(size), identity_(identity), tree_(IS_WIDE ? 0 : 2 * size_, identity) {
+    if constexpr (IS_WIDE) {
+        InitWide();
+    }
+}
 
 // Query function
-template <typename T, typename U, auto op, auto update>
-T SegmentTree<T, U, op, update>::Query(int left, int right) {
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+T SegmentTree<T, U, op, update, Layout, StatsPolicy>::Query(int left, int right) const {
+    stats_.CountQuery();
+    if constexpr (IS_WIDE) {
+        return QueryWide(left, right);
+    }
+
     T left_result = identity_, right_result = identity_;
     left += size_, right += size_;
 
     while (left < right) {
         if (left % 2 == 1) {
             left_result = op(left_result, tree_[left]);
+            CountNode();
             ++left;
         }
         if (right % 2 == 1) {
             --right;
             right_result = op(tree_[right], right_result);
+            CountNode();
         }
         left /= 2, right /= 2;
     }
 
+    stats_.CountOps();
     return op(left_result, right_result);
 }
 
+// Batched query function
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::QueryBatch(std::span<const std::pair<int, int>> queries, std::span<T> out) const {
+    assert(out.size() >= queries.size());
+
+    // A wide layout already touches very few cache lines per query
+    if constexpr (IS_WIDE) {
+        for (std::size_t i = 0; i < queries.size(); ++i) {
+            stats_.CountQuery();
+            out[i] = QueryWide(queries[i].first, queries[i].second);
+        }
+        return;
+    }
+
+    int left[BATCH_SIZE], right[BATCH_SIZE];
+    std::vector<T> right_result(BATCH_SIZE, identity_); // Left results are accumulated directly in `out`
+
+    for (std::size_t base = 0; base < queries.size(); base += BATCH_SIZE) {
+        int count = static_cast<int>(std::min<std::size_t>(BATCH_SIZE, queries.size() - base));
+        T* left_result = out.data() + base;
+
+        for (int k = 0; k < count; ++k) {
+            stats_.CountQuery();
+            left[k] = queries[base + k].first + size_;
+            right[k] = queries[base + k].second + size_;
+            left_result[k] = identity_;
+            right_result[k] = identity_;
+        }
+
+        // Advance every query of the group by one level per pass
+        bool active = true;
+        while (active) {
+            active = false;
+            for (int k = 0; k < count; ++k) {
+                int l = left[k], r = right[k];
+                if (l >= r) continue;
+
+                if (l % 2 == 1) {
+                    left_result[k] = op(left_result[k], tree_[l]);
+                    CountNode();
+                    ++l;
+                }
+                if (r % 2 == 1) {
+                    --r;
+                    right_result[k] = op(tree_[r], right_result[k]);
+                    CountNode();
+                }
+                l /= 2, r /= 2;
+                left[k] = l, right[k] = r;
+
+                // Fetch the next level while the other queries of the group are processed
+                if (l < r) {
+                    __builtin_prefetch(&tree_[l]);
+                    __builtin_prefetch(&tree_[r - 1]);
+                    active = true;
+                }
+            }
+        }
+
+        for (int k = 0; k < count; ++k) {
+            left_result[k] = op(left_result[k], right_result[k]);
+        }
+        stats_.CountOps(count);
+    }
+}
+
+// Binary search for the end of a range
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <typename Pred>
+int SegmentTree<T, U, op, update, Layout, StatsPolicy>::MaxRight(int left, Pred pred) const {
+    assert(pred(identity_));
+    stats_.CountQuery();
+    if constexpr (IS_WIDE) {
+        return MaxRightWide(left, pred);
+    }
+
+    // Nodes covering [left, size_) from left to right: found at the left end in order,
+    // then at the right end in reverse order
+    std::array<int, 64> nodes, right_nodes;
+    int count = 0, right_count = 0;
+    for (int l = left + size_, r = 2 * size_; l < r; l /= 2, r /= 2) {
+        if (l % 2 == 1) nodes[count++] = l++;
+        if (r % 2 == 1) right_nodes[right_count++] = --r;
+    }
+    while (right_count > 0) {
+        nodes[count++] = right_nodes[--right_count];
+    }
+
+    T result = identity_;
+    for (int k = 0; k < count; ++k) {
+        int node = nodes[k];
+        T next = op(result, tree_[node]);
+        CountNode();
+        if (pred(next)) {
+            result = next;
+            continue;
+        }
+
+        // The answer is in this node: go down, moving right whenever the left child still satisfies pred
+        while (node < size_) {
+            node *= 2;
+            next = op(result, tree_[node]);
+            CountNode();
+            if (pred(next)) {
+                result = next;
+                ++node;
+            }
+        }
+        return node - size_;
+    }
+    return size_;
+}
+
+// Binary search for the start of a range
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <typename Pred>
+int SegmentTree<T, U, op, update, Layout, StatsPolicy>::MinLeft(int right, Pred pred) const {
+    assert(pred(identity_));
+    stats_.CountQuery();
+    if constexpr (IS_WIDE) {
+        return MinLeftWide(right, pred);
+    }
+
+    // Nodes covering [0, right) from right to left: found at the right end in order,
+    // then at the left end in reverse order
+    std::array<int, 64> nodes, left_nodes;
+    int count = 0, left_count = 0;
+    for (int l = size_, r = right + size_; l < r; l /= 2, r /= 2) {
+        if (l % 2 == 1) left_nodes[left_count++] = l++;
+        if (r % 2 == 1) nodes[count++] = --r;
+    }
+    while (left_count > 0) {
+        nodes[count++] = left_nodes[--left_count];
+    }
+
+    T result = identity_;
+    for (int k = 0; k < count; ++k) {
+        int node = nodes[k];
+        T next = op(tree_[node], result);
+        CountNode();
+        if (pred(next)) {
+            result = next;
+            continue;
+        }
+
+        // The answer is in this node: go down, moving left whenever the right child still satisfies pred
+        while (node < size_) {
+            node = 2 * node + 1;
+            next = op(tree_[node], result);
+            CountNode();
+            if (pred(next)) {
+                result = next;
+                --node;
+            }
+        }
+        return node + 1 - size_;
+    }
+    return 0;
+}
+
 // Update function
-template <typename T, typename U, auto op, auto update>
-void SegmentTree<T, U, op, update>::Update(int pos, U value) {
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::Update(int pos, U value) {
+    stats_.CountUpdate();
+    if constexpr (IS_WIDE) {
+        UpdateWide(pos, value);
+        return;
+    }
+
     pos += size_;
     tree_[pos] = update(tree_[pos], value);
+    stats_.CountNodes();
     pos /= 2;
-    
+
     // Propagate the update up the tree
     while(pos > 0) {
         tree_[pos] = op(tree_[2 * pos], tree_[2 * pos + 1]);
+        CountNode();
         pos /= 2;
     }
 }
 
+// Batch update function
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::UpdateBatch(std::span<const std::pair<int, U>> updates, int threads) {
+    // Listing the dirty nodes costs O(N / 64): not worth it for a handful of updates
+    if (static_cast<long long>(updates.size()) * BATCH_UPDATE_RATIO < size_) {
+        for (const auto& [pos, value] : updates) {
+            Update(pos, value);
+        }
+        return;
+    }
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Update the leaves in order, so that repeated positions compose like sequential updates,
+    // and mark their parents (blocks of the level above for wide layouts)
+    int parents = IS_WIDE ? offsets_[1] / B : size_;
+    std::vector<std::uint64_t> marks((parents + 63) / 64);
+    for (const auto& [pos, value] : updates) {
+        stats_.CountUpdate();
+        stats_.CountNodes();
+        int leaf = IS_WIDE ? pos : pos + size_;
+        tree_[leaf] = update(tree_[leaf], value);
+        int parent = IS_WIDE ? pos / B : leaf / 2;
+        marks[parent / 64] |= std::uint64_t{1} << (parent % 64);
+    }
+
+    // Scanning the marks lists the dirty parents sorted and without duplicates
+    std::vector<int> dirty;
+    for (int word = 0; word < static_cast<int>(marks.size()); ++word) {
+        for (std::uint64_t bits = marks[word]; bits != 0; bits &= bits - 1) {
+            dirty.push_back(word * 64 + std::countr_zero(bits));
+        }
+    }
+
+    if constexpr (IS_WIDE) {
+        RecomputeWide(dirty, threads);
+    } else {
+        RecomputeBinary(dirty, threads);
+    }
+}
+
 // Access operator
-template <typename T, typename U, auto op, auto update>
-const T& SegmentTree<T, U, op, update>::operator[](int index) const {
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+const T& SegmentTree<T, U, op, update, Layout, StatsPolicy>::operator[](int index) const {
+    if constexpr (IS_WIDE) {
+        return tree_[index];
+    }
     return tree_[index + size_];
 }
 
+// Counters of the queries and updates
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+OperationStats SegmentTree<T, U, op, update, Layout, StatsPolicy>::Stats() const {
+    return stats_.Get();
+}
+
+// Reset the counters
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::ResetStats() {
+    stats_.Reset();
+}
+
+// Count nodes combined into a result with one call to `op` each
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::CountNode(int count) const {
+    stats_.CountNodes(count);
+    stats_.CountOps(count);
+}
+
+// Compute the level offsets of a wide layout
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::InitWide() {
+    // Every level is padded to a multiple of B, up to a root level holding a single node
+    // (also padded, so that whole blocks can always be read)
+    int total = 0, count = std::max(size_, 1);
+    while (true) {
+        offsets_.push_back(total);
+        if (count == 1 && total > 0) {
+            total += B;
+            break;
+        }
+        count = (count + B - 1) / B * B;
+        total += count;
+        count /= B;
+    }
+    tree_.assign(total, identity_);
+}
+
+// Build the levels of a wide layout bottom-up
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::BuildWide(int threads) {
+    for (int level = 1; level < static_cast<int>(offsets_.size()); ++level) {
+        int blocks = (offsets_[level] - offsets_[level - 1]) / B;
+        ParallelFor(0, blocks, threads,
+                    [&](int i) { tree_[offsets_[level] + i] = CombineBlock(level - 1, i * B); });
+    }
+}
+
+// Recompute dirty nodes of the binary layout
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::RecomputeBinary(std::vector<int>& dirty, int threads) {
+    // Round r holds the ancestors r + 1 levels above the updated leaves. The parents of a sorted
+    // round are sorted too, so duplicates are always adjacent
+    while (!dirty.empty()) {
+        if (dirty.front() == 0) {
+            dirty.erase(dirty.begin());
+            continue;
+        }
+
+        // Since leaves have different depths, the first (smallest) node of a round may be the parent of another
+        // node of the same round: compute it last. It is computed again in the next round, as their parent
+        int count = static_cast<int>(dirty.size());
+        auto recompute = [&](int k) {
+            int i = dirty[k];
+            tree_[i] = op(tree_[2 * i], tree_[2 * i + 1]);
+        };
+        ParallelFor(1, count, threads, recompute);
+        recompute(0);
+        stats_.CountNodes(count);
+        stats_.CountOps(count);
+
+        int parents = 0;
+        for (int k = 0; k < count; ++k) {
+            if (parents == 0 || dirty[parents - 1] != dirty[k] / 2) {
+                dirty[parents++] = dirty[k] / 2;
+            }
+        }
+        dirty.resize(parents);
+    }
+}
+
+// Recompute dirty blocks of a wide layout
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::RecomputeWide(std::vector<int>& dirty, int threads) {
+    // Levels are aligned, so the dirty nodes of a level are exactly the parents of those below
+    for (int level = 1; level < static_cast<int>(offsets_.size()); ++level) {
+        ParallelFor(0, static_cast<int>(dirty.size()), threads, [&](int k) {
+            tree_[offsets_[level] + dirty[k]] = CombineBlock(level - 1, dirty[k] * B);
+        });
+        stats_.CountNodes(dirty.size());
+        stats_.CountOps(BLOCK_OPS * dirty.size());
+
+        int parents = 0;
+        for (int node : dirty) {
+            if (parents == 0 || dirty[parents - 1] != node / B) {
+                dirty[parents++] = node / B;
+            }
+        }
+        dirty.resize(parents);
+    }
+}
+
+// Run body(i) over [begin, end) on several threads
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <typename F>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::ParallelFor(int begin, int end, int threads, F body) {
+    // Small ranges are not worth starting threads for
+    threads = std::min(threads, (end - begin) / PARALLEL_GRAIN);
+    if (threads <= 1) {
+        for (int i = begin; i < end; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    int chunk = (end - begin + threads - 1) / threads;
+    for (int lo = begin; lo < end; lo += chunk) {
+        int hi = std::min(end, lo + chunk);
+        workers.emplace_back([lo, hi, &body] {
+            for (int i = lo; i < hi; ++i) {
+                body(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Combine the B children starting at `block`
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+T SegmentTree<T, U, op, update, Layout, StatsPolicy>::CombineBlock(int level, int block) const {
+    const T* children = tree_.data() + offsets_[level] + block;
+    if constexpr (IS_SIMD) {
+        return ReduceBlock(children);
+    }
+
+    T result = children[0];
+    for (int i = 1; i < B; ++i) {
+        result = op(result, children[i]);
+    }
+    return result;
+}
+
+// Reduce a whole block with SIMD instructions
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+T SegmentTree<T, U, op, update, Layout, StatsPolicy>::ReduceBlock(const T* block) const {
+    using Vector = SimdVector<T, LANES>;
+
+    // Fold the registers of the block into one, then reduce it horizontally
+    Vector result, values;
+    std::memcpy(&result, block, sizeof(Vector));
+    for (int chunk = LANES; chunk < B; chunk += LANES) {
+        std::memcpy(&values, block + chunk, sizeof(Vector));
+        CombineVectors(result, values);
+    }
+    return ReduceVector<LANES>(result);
+}
+
+// Combine two vectors lane by lane
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <typename V>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::CombineVectors(V& acc, const V& other) {
+    if constexpr (IS_SUM) {
+        acc += other;
+    } else if constexpr (IS_MIN) {
+        acc = other < acc ? other : acc;
+    } else {
+        acc = acc < other ? other : acc;
+    }
+}
+
+// Reduce a vector by halves
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <int N>
+T SegmentTree<T, U, op, update, Layout, StatsPolicy>::ReduceVector(const SimdVector<T, N>& v) {
+    if constexpr (N == 2) {
+        return op(v[0], v[1]);
+    } else {
+        SimdVector<T, N / 2> low, high;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            low = __builtin_shufflevector(v, v, I...);
+            high = __builtin_shufflevector(v, v, (I + N / 2)...);
+        }(std::make_index_sequence<N / 2>{});
+        CombineVectors(low, high);
+        return ReduceVector<N / 2>(low);
+    }
+}
+
+// Query function for wide layouts
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+T SegmentTree<T, U, op, update, Layout, StatsPolicy>::QueryWide(int left, int right) const {
+    // Known reductions are commutative, so the partial blocks of every level can be folded
+    // into one vector accumulator, with a single horizontal reduction at the end
+    if constexpr (IS_SIMD) {
+        using Vector = SimdVector<T, LANES>;
+        using Mask = SimdVector<Lane, LANES>;
+
+        Vector identity = Vector{} + identity_, result = identity, values;
+        Mask lanes;
+
+        for (int level = 0; left < right; ++level) {
+            const T* row = tree_.data() + offsets_[level];
+            int left_block = (left + B - 1) & ~(B - 1);
+            int right_block = right & ~(B - 1);
+
+            // Partial blocks of this level: block[k] contributes its values [lo[k], hi[k])
+            int block[2], lo[2], hi[2], count = 0;
+            if (left_block > right_block) {
+                block[0] = left & ~(B - 1), lo[0] = left - block[0], hi[0] = right - block[0];
+                count = 1;
+            } else {
+                if (left < left_block) {
+                    block[count] = left_block - B, lo[count] = left - block[count], hi[count] = B;
+                    ++count;
+                }
+                if (right_block < right) {
+                    block[count] = right_block, lo[count] = 0, hi[count] = right - right_block;
+                    ++count;
+                }
+            }
+
+            for (int k = 0; k < count; ++k) {
+                for (int chunk = 0; chunk < B; chunk += LANES) {
+                    if (chunk + LANES <= lo[k] || chunk >= hi[k]) continue;
+
+                    // Replace the values outside of [lo, hi) with the identity
+                    std::memcpy(&values, row + block[k] + chunk, sizeof(Vector));
+                    std::memcpy(&lanes, LANE_INDEX.data() + chunk, sizeof(Mask));
+                    Mask keep = (lanes >= static_cast<Lane>(lo[k])) & (lanes < static_cast<Lane>(hi[k]));
+                    values = keep ? values : identity;
+                    CombineVectors(result, values);
+                }
+                stats_.CountNodes(hi[k] - lo[k]);
+            }
+
+            if (left_block > right_block) break;
+            left = left_block / B, right = right_block / B;
+        }
+        stats_.CountOps();
+        return ReduceVector<LANES>(result);
+    }
+
+    T left_result = identity_, right_result = identity_;
+
+    for (int level = 0; left < right; ++level) {
+        const T* row = tree_.data() + offsets_[level];
+
+        // [left, left_block) and [right_block, right) are the partial blocks at both ends
+        int left_block = (left + B - 1) & ~(B - 1);
+        int right_block = right & ~(B - 1);
+
+        // Both ends lie in the same block
+        if (left_block > right_block) {
+            for (int i = left; i < right; ++i) {
+                left_result = op(left_result, row[i]);
+            }
+            CountNode(right - left);
+            break;
+        }
+
+        for (int i = left; i < left_block; ++i) {
+            left_result = op(left_result, row[i]);
+        }
+        for (int i = right - 1; i >= right_block; --i) {
+            right_result = op(row[i], right_result);
+        }
+        CountNode(left_block - left + right - right_block);
+        left = left_block / B, right = right_block / B;
+    }
+
+    stats_.CountOps();
+    return op(left_result, right_result);
+}
+
+// Update function for wide layouts
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+void SegmentTree<T, U, op, update, Layout, StatsPolicy>::UpdateWide(int pos, U value) {
+    tree_[pos] = update(tree_[pos], value);
+    stats_.CountNodes();
+
+    // Recompute the block containing `pos` at every level
+    for (int level = 1; level < static_cast<int>(offsets_.size()); ++level) {
+        int block = pos & ~(B - 1);
+        pos /= B;
+        tree_[offsets_[level] + pos] = CombineBlock(level - 1, block);
+        stats_.CountNodes();
+        stats_.CountOps(BLOCK_OPS);
+    }
+}
+
+// MaxRight for wide layouts
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <typename Pred>
+int SegmentTree<T, U, op, update, Layout, StatsPolicy>::MaxRightWide(int left, Pred& pred) const {
+    T result = identity_;
+    int levels = static_cast<int>(offsets_.size());
+
+    // Climb: at every level, scan from `pos` to the end of its block, then continue with the next block above
+    for (int level = 0, pos = left; level < levels; ++level) {
+        const T* row = tree_.data() + offsets_[level];
+        int level_end = (level + 1 < levels ? offsets_[level + 1] : static_cast<int>(tree_.size())) - offsets_[level];
+        int block_end = std::min((pos | (B - 1)) + 1, level_end);
+
+        for (; pos < block_end; ++pos) {
+            T next = op(result, row[pos]);
+            CountNode();
+            if (pred(next)) {
+                result = next;
+                continue;
+            }
+
+            // The answer is in this node: go down to the first child that fails pred
+            for (; level > 0; --level) {
+                row = tree_.data() + offsets_[level - 1];
+                pos *= B;
+                for (int last = pos + B - 1; pos < last; ++pos) {
+                    next = op(result, row[pos]);
+                    CountNode();
+                    if (!pred(next)) break;
+                    result = next;
+                }
+            }
+            return pos;
+        }
+        pos = block_end / B;
+    }
+    return size_;
+}
+
+// MinLeft for wide layouts
+template <typename T, typename U, auto op, auto update, typename Layout, typename StatsPolicy>
+template <typename Pred>
+int SegmentTree<T, U, op, update, Layout, StatsPolicy>::MinLeftWide(int right, Pred& pred) const {
+    T result = identity_;
+    int levels = static_cast<int>(offsets_.size());
+
+    // Climb: at every level, scan from `pos - 1` down to the start of its block, then continue with the block above
+    for (int level = 0, pos = right; level < levels && pos > 0; ++level) {
+        const T* row = tree_.data() + offsets_[level];
+        int block_start = (pos - 1) & ~(B - 1);
+
+        for (; pos > block_start; --pos) {
+            T next = op(row[pos - 1], result);
+            CountNode();
+            if (pred(next)) {
+                result = next;
+                continue;
+            }
+
+            // The answer is in this node: go down to the last child that fails pred
+            int node = pos - 1;
+            for (; level > 0; --level) {
+                row = tree_.data() + offsets_[level - 1];
+                node = node * B + B - 1;
+                for (int first = node - B + 1; node > first; --node) {
+                    next = op(row[node], result);
+                    CountNode();
+                    if (!pred(next)) break;
+                    result = next;
+                }
+            }
+            return node + 1;
+        }
+        pos = block_start / B;
+    }
+    return 0;
+}
+
 #endif // SEGMENTTREE_CPP
@@ -2,9 +2,21 @@
 #define SEGMENTTREE_HPP
 
 #include <algorithm>  // For std::copy
+#include <array>      // For std::array
+#include <bit>        // For std::bit_floor, std::countr_zero
 #include <cassert>    // For assert
+#include <cstddef>    // For std::size_t
+#include <cstdint>    // For std::int8_t, std::int16_t, ...
+#include <cstring>    // For std::memcpy
 #include <functional> // For std::invoke
+#include <iterator>   // For std::random_access_iterator
+#include <new>        // For std::align_val_t
+#include <span>       // For std::span
+#include <thread>     // For std::thread
+#include <type_traits> // For std::is_same_v
+#include <utility>    // For std::pair, std::index_sequence
 #include <vector>     // For std::vector
+#include "../../Utilities/Stats/Stats.hpp"
 
 // Concept to ensure the type is an iterator
 template <typename Iter>
@@ -12,6 +24,84 @@ concept Iterator = requires(Iter it) {
     typename std::iterator_traits<Iter>::iterator_category;
 };
 
+/**
+ * Layout policies for SegmentTree.
+ *
+ * BinaryLayout is the classic bottom-up layout: node i has children 2i and 2i + 1.
+ * WideLayout<B> stores a B-ary tree level by level, with the B children of a node next to
+ * each other, so one step up the tree reads a single block instead of jumping across the array.
+ * Choose B so that B * sizeof(T) is a cache line (e.g. WideLayout<16> for int).
+ */
+struct BinaryLayout {
+    static constexpr int BRANCHING = 2;
+};
+
+template <int B>
+struct WideLayout {
+    static_assert(B >= 2 && (B & (B - 1)) == 0, "The branching factor must be a power of two");
+    static constexpr int BRANCHING = B;
+};
+
+// Allocator aligning the tree to cache lines, so that a block of a wide layout spans as few lines as possible
+template <typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    CacheAlignedAllocator() = default;
+    template <typename V>
+    CacheAlignedAllocator(const CacheAlignedAllocator<V>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t{ALIGNMENT});
+    }
+
+    template <typename V>
+    bool operator==(const CacheAlignedAllocator<V>&) const { return true; }
+};
+
+/**
+ * Reductions that SegmentTree recognizes at compile time.
+ * With an arithmetic T and a WideLayout, whole blocks are reduced with SIMD instructions
+ * instead of B - 1 calls to `op`. Any other `op` uses the generic path.
+ */
+struct SumOp {
+    template <typename V>
+    constexpr V operator()(const V& a, const V& b) const { return a + b; }
+};
+
+struct MinOp {
+    template <typename V>
+    constexpr V operator()(const V& a, const V& b) const { return b < a ? b : a; }
+};
+
+struct MaxOp {
+    template <typename V>
+    constexpr V operator()(const V& a, const V& b) const { return a < b ? b : a; }
+};
+
+// Width in bytes of the vector registers used by the SIMD path (0 disables it).
+// 16-byte SSE registers are too narrow to beat the scalar loop, so they are not used.
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+inline constexpr int SIMD_BYTES = 64;
+#elif defined(__AVX2__)
+inline constexpr int SIMD_BYTES = 32;
+#else
+inline constexpr int SIMD_BYTES = 0;
+#endif
+
+// GCC/Clang vector extension type holding N values of type T
+template <typename T, int N>
+struct SimdVectorOf {
+    typedef T type __attribute__((vector_size(N * sizeof(T))));
+};
+
+template <typename T, int N>
+using SimdVector = typename SimdVectorOf<T, N>::type;
+
 /**
  * Segment Tree implementation with customizable operation and update functions.
  *
@@ -19,8 +109,10 @@ concept Iterator = requires(Iter it) {
  * @tparam U The type of the update value.
  * @tparam op The operation function (e.g., sum, min, max).
  * @tparam update The update function to apply to elements.
+ * @tparam Layout How the tree is stored in memory (BinaryLayout or WideLayout<B>).
+ * @tparam StatsPolicy NoStats, or CountStats to count the work of queries and updates (see Stats()).
  */
-template <typename T, typename U, auto op, auto update>
+template <typename T, typename U, auto op, auto update, typename Layout = BinaryLayout, typename StatsPolicy = NoStats>
 class SegmentTree {
     // Helper to check if `op` is callable with T or T&
     template <typename F, typename A, typename B>
@@ -50,6 +142,19 @@ public:
      */
     template <Iterator Iter>
     explicit SegmentTree(Iter start, Iter end, T identity);
+
+    /**
+     * Constructs a SegmentTree from a range of elements, building it with several threads.
+     * The result is identical to the serial build.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     * @param identity The identity element for the operation (e.g., 0 for sum, INF for min).
+     * @param threads The number of threads to use (0 for one per hardware thread).
+     */
+    template <Iterator Iter>
+    explicit SegmentTree(Iter start, Iter end, T identity, int threads);
+
     /**
      * Constructs a SegmentTree with a given size and identity element.
      * All entries are initially set to the identity.
@@ -61,12 +166,47 @@ public:
 
     /**
      * Queries the range [left, right).
+     * Read only with NoStats, so any number of threads can query the same tree at once while
+     * nothing updates it. See ConcurrentSegmentTree for queries running alongside updates.
      *
      * @param left The left index (inclusive).
      * @param right The right index (exclusive).
      * @return The result of the operation over the range.
      */
-    T Query(int left, int right);
+    T Query(int left, int right) const;
+
+    /**
+     * Answers many independent queries at once.
+     * Queries are processed in groups whose bottom-up walks are interleaved level by level,
+     * and the nodes needed by the next level are prefetched, so cache misses of different
+     * queries overlap instead of being paid one after another.
+     *
+     * @param queries The ranges [left, right) to query.
+     * @param out Output buffer, out[i] receives the result of queries[i]. Must be at least as large as `queries`.
+     */
+    void QueryBatch(std::span<const std::pair<int, int>> queries, std::span<T> out) const;
+
+    /**
+     * Finds the largest `right` such that pred(Query(left, right)) is true, in a single walk of the tree.
+     * `pred` must be true for the identity, and once false for a range, false for every longer range.
+     *
+     * @param left The left index (inclusive).
+     * @param pred The predicate, called with the aggregate of a range.
+     * @return The largest right in [left, N] such that pred(Query(left, right)) is true.
+     */
+    template <typename Pred>
+    int MaxRight(int left, Pred pred) const;
+
+    /**
+     * Finds the smallest `left` such that pred(Query(left, right)) is true, in a single walk of the tree.
+     * `pred` must be true for the identity, and once false for a range, false for every longer range.
+     *
+     * @param right The right index (exclusive).
+     * @param pred The predicate, called with the aggregate of a range.
+     * @return The smallest left in [0, right] such that pred(Query(left, right)) is true.
+     */
+    template <typename Pred>
+    int MinLeft(int right, Pred pred) const;
 
     /**
      * Updates the element at the given position.
@@ -76,6 +216,16 @@ public:
      */
     void Update(int pos, U value);
 
+    /**
+     * Applies many point updates at once.
+     * All leaves are updated first, in the order of `updates`, then every ancestor of an updated leaf
+     * is recomputed exactly once, level by level, instead of once per update.
+     *
+     * @param updates The pairs {pos, value}, applied as Update(pos, value).
+     * @param threads The number of threads used to recompute a level (0 for one per hardware thread).
+     */
+    void UpdateBatch(std::span<const std::pair<int, U>> updates, int threads = 1);
+
     /**
      * Accesses the element at the given index.
      *
@@ -84,10 +234,130 @@ public:
      */
     const T& operator[](int index) const;
 
+    /**
+     * Gets the work done by queries and updates since construction or the last ResetStats().
+     * Always zero with NoStats.
+     *
+     * @return The counters.
+     */
+    OperationStats Stats() const;
+
+    /**
+     * Resets the counters returned by Stats().
+     */
+    void ResetStats();
+
 private:
-    int size_;            // Number of elements in the tree
-    T identity_;          // Identity element for the operation
-    std::vector<T> tree_; // The underlying tree structure
+    static constexpr int BATCH_SIZE = 32; // Number of queries interleaved by QueryBatch
+    static constexpr int BATCH_UPDATE_RATIO = 1024; // UpdateBatch falls back to Update below N / ratio updates
+    static constexpr int PARALLEL_GRAIN = 1 << 14; // Minimum number of nodes per thread in a parallel build
+    static constexpr int B = Layout::BRANCHING;
+    static constexpr bool IS_WIDE = !std::is_same_v<Layout, BinaryLayout>;
+
+    // Compile-time selection of the SIMD path: a wide layout, an arithmetic T and a known reduction
+    using Op = std::remove_cv_t<decltype(op)>;
+    static constexpr bool IS_SUM = std::is_same_v<Op, SumOp> || std::is_same_v<Op, std::plus<T>> ||
+                                   std::is_same_v<Op, std::plus<>>;
+    static constexpr bool IS_MIN = std::is_same_v<Op, MinOp>;
+    static constexpr bool IS_MAX = std::is_same_v<Op, MaxOp>;
+    static constexpr int LANES = std::min<int>(B, SIMD_BYTES / sizeof(T)); // Values per vector register
+    static constexpr bool IS_SIMD = IS_WIDE && (IS_SUM || IS_MIN || IS_MAX) && std::is_arithmetic_v<T> &&
+                                    !std::is_same_v<T, bool> && !std::is_same_v<T, long double> && LANES >= 2;
+    static constexpr int BLOCK_OPS = IS_SIMD ? 1 : B - 1; // Calls to `op` by CombineBlock
+
+    // Signed integer with the width of T, used for lane masks
+    using Lane = std::conditional_t<sizeof(T) == 1, std::int8_t,
+                 std::conditional_t<sizeof(T) == 2, std::int16_t,
+                 std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>>>;
+    static constexpr std::array<Lane, B> LANE_INDEX = [] {
+        std::array<Lane, B> lanes{};
+        for (int i = 0; i < B; ++i) lanes[i] = static_cast<Lane>(i);
+        return lanes;
+    }();
+
+    int size_;                  // Number of elements in the tree
+    T identity_;                // Identity element for the operation
+    std::vector<T, CacheAlignedAllocator<T>> tree_; // The underlying tree structure
+    std::vector<int> offsets_;  // Start of each level in `tree_`, leaves first (wide layouts only)
+    [[no_unique_address]] StatsPolicy stats_; // Counters of the queries and updates (empty with NoStats)
+
+    /**
+     * Counts nodes combined into a result with one call to `op` each.
+     *
+     * @param count The number of nodes.
+     */
+    void CountNode(int count = 1) const;
+
+    /**
+     * Computes the level offsets of a wide layout and fills the tree with the identity.
+     */
+    void InitWide();
+
+    /**
+     * Builds every level of a wide layout above the leaves.
+     *
+     * @param threads The number of threads to use.
+     */
+    void BuildWide(int threads);
+
+    /**
+     * Recomputes the nodes in `dirty`, then their parents, level by level up to the root.
+     *
+     * @param dirty The nodes to recompute, sorted and without duplicates. Used as scratch space.
+     * @param threads The number of threads to use.
+     */
+    void RecomputeBinary(std::vector<int>& dirty, int threads);
+    void RecomputeWide(std::vector<int>& dirty, int threads);
+
+    /**
+     * Runs body(i) for every i in [begin, end), split into contiguous chunks over several threads.
+     *
+     * @param begin The first index.
+     * @param end One past the last index.
+     * @param threads The maximum number of threads to use.
+     * @param body The function to run for each index.
+     */
+    template <typename F>
+    static void ParallelFor(int begin, int end, int threads, F body);
+
+    /**
+     * Combines the B children of block `block` in level `level` (wide layouts only).
+     *
+     * @param level The level the children are in.
+     * @param block The index of the first child.
+     * @return The result of the operation over the block.
+     */
+    T CombineBlock(int level, int block) const;
+
+    /**
+     * Reduces a whole block of B values with SIMD instructions (SIMD path only).
+     *
+     * @param block Pointer to the first value of the block.
+     * @return The result of the operation over the block.
+     */
+    T ReduceBlock(const T* block) const;
+
+    /**
+     * Combines `other` into `acc` lane by lane with the known reduction.
+     */
+    template <typename V>
+    static void CombineVectors(V& acc, const V& other);
+
+    /**
+     * Reduces all N lanes of a vector by repeatedly combining its two halves.
+     */
+    template <int N>
+    static T ReduceVector(const SimdVector<T, N>& v);
+
+    /**
+     * Query, Update, MaxRight and MinLeft for wide layouts.
+     */
+    T QueryWide(int left, int right) const;
+    void UpdateWide(int pos, U value);
+    template <typename Pred>
+    int MaxRightWide(int left, Pred& pred) const;
+    template <typename Pred>
+    int MinLeftWide(int right, Pred& pred) const;
 };
 
 // Include the implementation file for templates
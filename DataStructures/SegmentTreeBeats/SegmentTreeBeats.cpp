@@ -0,0 +1,327 @@
+#ifndef SEGMENTTREEBEATS_CPP
+#define SEGMENTTREEBEATS_CPP
+
+#include "SegmentTreeBeats.hpp"
+
+// Constructor from a range of elements
+template <typename T, typename Sum>
+SegmentTreeBeats<T, Sum>::SegmentTreeBeats(auto start, auto end)
+    : size_(static_cast<int>(std::distance(start, end))),
+      tree_(2 * std::bit_ceil(static_cast<unsigned>(std::max(size_, 1)))) {
+    if (size_ > 0) {
+        Build(1, 0, size_, std::vector<T>(start, end));
+    }
+}
+
+// Constructor with a given size and value
+template <typename T, typename Sum>
+SegmentTreeBeats<T, Sum>::SegmentTreeBeats(int size, T value)
+    : size_(size),
+      tree_(2 * std::bit_ceil(static_cast<unsigned>(std::max(size_, 1)))) {
+    if (size_ > 0) {
+        Build(1, 0, size_, std::vector<T>(size_, value));
+    }
+}
+
+// Range chmin function
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::ChMin(int left, int right, T value) {
+    if (left < right) {
+        ChMin(1, 0, size_, left, right, value);
+    }
+}
+
+// Range chmax function
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::ChMax(int left, int right, T value) {
+    if (left < right) {
+        ChMax(1, 0, size_, left, right, value);
+    }
+}
+
+// Range addition function
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::Add(int left, int right, T value) {
+    if (left < right) {
+        Add(1, 0, size_, left, right, value);
+    }
+}
+
+// Range sum query
+template <typename T, typename Sum>
+Sum SegmentTreeBeats<T, Sum>::QuerySum(int left, int right) {
+    return left < right ? QuerySum(1, 0, size_, left, right) : Sum{};
+}
+
+// Range maximum query
+template <typename T, typename Sum>
+T SegmentTreeBeats<T, Sum>::QueryMax(int left, int right) {
+    return left < right ? QueryMax(1, 0, size_, left, right) : LOWEST;
+}
+
+// Range minimum query
+template <typename T, typename Sum>
+T SegmentTreeBeats<T, Sum>::QueryMin(int left, int right) {
+    return left < right ? QueryMin(1, 0, size_, left, right) : HIGHEST;
+}
+
+// Build the tree recursively
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::Build(int node, int lo, int hi, const std::vector<T>& values) {
+    if (hi - lo == 1) {
+        T value = values[lo];
+        tree_[node] = Node{value, LOWEST, value, HIGHEST, 1, 1, static_cast<Sum>(value), Sum{}};
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    Build(2 * node, lo, mid, values);
+    Build(2 * node + 1, mid, hi, values);
+    Pull(node);
+}
+
+// Recompute a node from its children
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::Pull(int node) {
+    const Node& l = tree_[2 * node];
+    const Node& r = tree_[2 * node + 1];
+    Node& cur = tree_[node];
+    cur.sum = l.sum + r.sum;
+
+    // Maximum: the second maximum is the largest value which is not the maximum
+    if (l.max1 == r.max1) {
+        cur.max1 = l.max1;
+        cur.max2 = std::max(l.max2, r.max2);
+        cur.maxCount = l.maxCount + r.maxCount;
+    } else if (l.max1 > r.max1) {
+        cur.max1 = l.max1;
+        cur.max2 = std::max(l.max2, r.max1);
+        cur.maxCount = l.maxCount;
+    } else {
+        cur.max1 = r.max1;
+        cur.max2 = std::max(l.max1, r.max2);
+        cur.maxCount = r.maxCount;
+    }
+
+    // Minimum: the same, mirrored
+    if (l.min1 == r.min1) {
+        cur.min1 = l.min1;
+        cur.min2 = std::min(l.min2, r.min2);
+        cur.minCount = l.minCount + r.minCount;
+    } else if (l.min1 < r.min1) {
+        cur.min1 = l.min1;
+        cur.min2 = std::min(l.min2, r.min1);
+        cur.minCount = l.minCount;
+    } else {
+        cur.min1 = r.min1;
+        cur.min2 = std::min(l.min1, r.min2);
+        cur.minCount = r.minCount;
+    }
+}
+
+// Push the lazy updates of a node to its children
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::Push(int node, int lo, int hi) {
+    int mid = (lo + hi) / 2;
+    Node& cur = tree_[node];
+
+    // Pending chmins and chmaxes are not stored: they are exactly the differences
+    // between the maximum (or minimum) of the node and those of its children
+    PushTo(2 * node, mid - lo, cur.add, cur.min1, cur.max1);
+    PushTo(2 * node + 1, hi - mid, cur.add, cur.min1, cur.max1);
+    cur.add = Sum{};
+}
+
+// Apply the lazy updates of a parent to a child
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::PushTo(int node, int length, Sum add, T low, T high) {
+    Node& cur = tree_[node];
+    bool single = cur.max1 == cur.min1;
+
+    // The values after the addition are computed as Sum: the ones that are clamped next can be
+    // outside the range of T (e.g. a child near the largest value of T, below a parent that was
+    // clamped down to the lowest value and then raised by an addition)
+    Sum max1 = static_cast<Sum>(cur.max1) + add, min1 = static_cast<Sum>(cur.min1) + add;
+    Sum max2 = single ? Sum{} : static_cast<Sum>(cur.max2) + add;
+    Sum min2 = single ? Sum{} : static_cast<Sum>(cur.min2) + add;
+    cur.sum += add * length;
+    cur.add += add;
+
+    // Only the maximum can be above the maximum of the parent, which might also be the minimum,
+    // or the second minimum
+    if (max1 > high) {
+        cur.sum -= (max1 - high) * cur.maxCount;
+        if (single) {
+            min1 = high;
+        } else if (min2 == max1) {
+            min2 = high;
+        }
+        max1 = high;
+    }
+
+    // The same for the minimum, mirrored
+    if (min1 < low) {
+        cur.sum += (low - min1) * cur.minCount;
+        if (single) {
+            max1 = low;
+        } else if (max2 == min1) {
+            max2 = low;
+        }
+        min1 = low;
+    }
+
+    cur.max1 = static_cast<T>(max1), cur.min1 = static_cast<T>(min1);
+    if (!single) {
+        cur.max2 = static_cast<T>(max2), cur.min2 = static_cast<T>(min2);
+    }
+}
+
+// Add a value to a whole node
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::ApplyAdd(int node, int length, T value) {
+    Node& cur = tree_[node];
+    // max2 and min2 are only real values when the node has two distinct values, and then they
+    // must move even if they are equal to LOWEST or HIGHEST
+    if (cur.max1 != cur.min1) {
+        cur.max2 += value;
+        cur.min2 += value;
+    }
+    cur.max1 += value;
+    cur.min1 += value;
+    cur.sum += static_cast<Sum>(value) * length;
+    cur.add += value;
+}
+
+// Lower the maximum of a whole node
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::ApplyChMin(int node, T value) {
+    Node& cur = tree_[node];
+    if (cur.max1 <= value) {
+        return;
+    }
+    cur.sum -= (static_cast<Sum>(cur.max1) - static_cast<Sum>(value)) * cur.maxCount;
+
+    // The maximum might also be the minimum, or the second minimum
+    if (cur.min1 == cur.max1) {
+        cur.min1 = value;
+    } else if (cur.min2 == cur.max1) {
+        cur.min2 = value;
+    }
+    cur.max1 = value;
+}
+
+// Raise the minimum of a whole node
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::ApplyChMax(int node, T value) {
+    Node& cur = tree_[node];
+    if (cur.min1 >= value) {
+        return;
+    }
+    cur.sum += (static_cast<Sum>(value) - static_cast<Sum>(cur.min1)) * cur.minCount;
+
+    // The minimum might also be the maximum, or the second maximum
+    if (cur.max1 == cur.min1) {
+        cur.max1 = value;
+    } else if (cur.max2 == cur.min1) {
+        cur.max2 = value;
+    }
+    cur.min1 = value;
+}
+
+// Recursive range chmin
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::ChMin(int node, int lo, int hi, int left, int right, T value) {
+    // Break condition: outside the range, or nothing to lower
+    if (right <= lo || hi <= left || tree_[node].max1 <= value) {
+        return;
+    }
+    // Tag condition: only the maximum changes (always true with a single distinct value, such as in a leaf)
+    if (left <= lo && hi <= right && (tree_[node].max1 == tree_[node].min1 || tree_[node].max2 < value)) {
+        ApplyChMin(node, value);
+        return;
+    }
+    Push(node, lo, hi);
+    int mid = (lo + hi) / 2;
+    ChMin(2 * node, lo, mid, left, right, value);
+    ChMin(2 * node + 1, mid, hi, left, right, value);
+    Pull(node);
+}
+
+// Recursive range chmax
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::ChMax(int node, int lo, int hi, int left, int right, T value) {
+    // Break condition: outside the range, or nothing to raise
+    if (right <= lo || hi <= left || tree_[node].min1 >= value) {
+        return;
+    }
+    // Tag condition: only the minimum changes (always true with a single distinct value, such as in a leaf)
+    if (left <= lo && hi <= right && (tree_[node].max1 == tree_[node].min1 || tree_[node].min2 > value)) {
+        ApplyChMax(node, value);
+        return;
+    }
+    Push(node, lo, hi);
+    int mid = (lo + hi) / 2;
+    ChMax(2 * node, lo, mid, left, right, value);
+    ChMax(2 * node + 1, mid, hi, left, right, value);
+    Pull(node);
+}
+
+// Recursive range addition
+template <typename T, typename Sum>
+void SegmentTreeBeats<T, Sum>::Add(int node, int lo, int hi, int left, int right, T value) {
+    if (right <= lo || hi <= left) {
+        return;
+    }
+    if (left <= lo && hi <= right) {
+        ApplyAdd(node, hi - lo, value);
+        return;
+    }
+    Push(node, lo, hi);
+    int mid = (lo + hi) / 2;
+    Add(2 * node, lo, mid, left, right, value);
+    Add(2 * node + 1, mid, hi, left, right, value);
+    Pull(node);
+}
+
+// Recursive range sum query
+template <typename T, typename Sum>
+Sum SegmentTreeBeats<T, Sum>::QuerySum(int node, int lo, int hi, int left, int right) {
+    if (right <= lo || hi <= left) {
+        return Sum{};
+    }
+    if (left <= lo && hi <= right) {
+        return tree_[node].sum;
+    }
+    Push(node, lo, hi);
+    int mid = (lo + hi) / 2;
+    return QuerySum(2 * node, lo, mid, left, right) + QuerySum(2 * node + 1, mid, hi, left, right);
+}
+
+// Recursive range maximum query
+template <typename T, typename Sum>
+T SegmentTreeBeats<T, Sum>::QueryMax(int node, int lo, int hi, int left, int right) {
+    if (right <= lo || hi <= left) {
+        return LOWEST;
+    }
+    if (left <= lo && hi <= right) {
+        return tree_[node].max1;
+    }
+    Push(node, lo, hi);
+    int mid = (lo + hi) / 2;
+    return std::max(QueryMax(2 * node, lo, mid, left, right), QueryMax(2 * node + 1, mid, hi, left, right));
+}
+
+// Recursive range minimum query
+template <typename T, typename Sum>
+T SegmentTreeBeats<T, Sum>::QueryMin(int node, int lo, int hi, int left, int right) {
+    if (right <= lo || hi <= left) {
+        return HIGHEST;
+    }
+    if (left <= lo && hi <= right) {
+        return tree_[node].min1;
+    }
+    Push(node, lo, hi);
+    int mid = (lo + hi) / 2;
+    return std::min(QueryMin(2 * node, lo, mid, left, right), QueryMin(2 * node + 1, mid, hi, left, right));
+}
+
+#endif // SEGMENTTREEBEATS_CPP
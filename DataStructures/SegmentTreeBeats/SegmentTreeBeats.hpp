@@ -0,0 +1,163 @@
+#ifndef SEGMENTTREEBEATS_HPP
+#define SEGMENTTREEBEATS_HPP
+
+#include <algorithm>   // For std::min, std::max
+#include <bit>         // For std::bit_ceil
+#include <iterator>    // For std::distance
+#include <limits>      // For std::numeric_limits
+#include <type_traits> // For std::is_arithmetic_v
+#include <vector>      // For std::vector
+
+/**
+ * Segment Tree Beats (Ji Ruyi's segment tree) implementation.
+ * Supports range chmin (a[i] = min(a[i], x)), range chmax (a[i] = max(a[i], x)) and range
+ * addition updates, with range sum, maximum and minimum queries.
+ *
+ * Each node keeps its maximum, its second largest distinct value and how many times its
+ * maximum occurs (and the same for the minimum), so that a chmin which only lowers the
+ * maximum of a node is applied to it directly, without visiting its children.
+ *
+ * @tparam T The type of elements stored in the tree (an arithmetic type).
+ * @tparam Sum The type of range sums (defaults to T, use a wider type if sums may overflow T).
+ */
+template <typename T, typename Sum = T>
+class SegmentTreeBeats {
+    static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<Sum>,
+                  "`T` and `Sum` must be arithmetic types");
+
+public:
+    /**
+     * Constructs a SegmentTreeBeats from a range of elements.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     */
+    explicit SegmentTreeBeats(auto start, auto end);
+
+    /**
+     * Constructs a SegmentTreeBeats with a given size, with every element equal to a value.
+     *
+     * @param size The number of elements in the tree.
+     * @param value The initial value of every element.
+     */
+    explicit SegmentTreeBeats(int size, T value = T{});
+
+    /**
+     * Sets every element of the range [left, right) to min(element, value).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @param value The upper bound to clamp the elements to.
+     */
+    void ChMin(int left, int right, T value);
+
+    /**
+     * Sets every element of the range [left, right) to max(element, value).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @param value The lower bound to clamp the elements to.
+     */
+    void ChMax(int left, int right, T value);
+
+    /**
+     * Adds a value to every element of the range [left, right).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @param value The value to add.
+     */
+    void Add(int left, int right, T value);
+
+    /**
+     * Queries the sum of the range [left, right).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @return The sum of the elements in the range (0 if it is empty).
+     */
+    Sum QuerySum(int left, int right);
+
+    /**
+     * Queries the maximum of the range [left, right).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @return The maximum of the elements in the range (the lowest value of T if it is empty).
+     */
+    T QueryMax(int left, int right);
+
+    /**
+     * Queries the minimum of the range [left, right).
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (exclusive).
+     * @return The minimum of the elements in the range (the largest value of T if it is empty).
+     */
+    T QueryMin(int left, int right);
+
+private:
+    static constexpr T LOWEST = std::numeric_limits<T>::lowest(); // Second maximum of a node with one distinct value
+    static constexpr T HIGHEST = std::numeric_limits<T>::max();   // Second minimum of a node with one distinct value
+
+    struct Node {
+        T max1, max2;      // Largest value, and largest value smaller than it (LOWEST if none, when max1 == min1)
+        T min1, min2;      // Smallest value, and smallest value larger than it (HIGHEST if none, when max1 == min1)
+        int maxCount;      // Number of elements equal to max1
+        int minCount;      // Number of elements equal to min1
+        Sum sum;           // Sum of the elements
+        Sum add;           // Lazy addition not yet applied to the children (a Sum, it can leave the range of T)
+    };
+
+    int size_;               // Number of elements in the tree
+    std::vector<Node> tree_; // The nodes: the root is 1, and the children of i are 2i and 2i + 1
+
+    /**
+     * Builds the subtree of a node covering [lo, hi) from the elements.
+     */
+    void Build(int node, int lo, int hi, const std::vector<T>& values);
+
+    /**
+     * Recomputes a node from its children.
+     */
+    void Pull(int node);
+
+    /**
+     * Pushes the lazy updates of a node covering [lo, hi) to its children.
+     */
+    void Push(int node, int lo, int hi);
+
+    /**
+     * Adds value to every element of a node covering length elements.
+     */
+    void ApplyAdd(int node, int length, T value);
+
+    /**
+     * Lowers the maximum of a node to value, which must be above its second maximum.
+     */
+    void ApplyChMin(int node, T value);
+
+    /**
+     * Raises the minimum of a node to value, which must be below its second minimum.
+     */
+    void ApplyChMax(int node, T value);
+
+    /**
+     * Applies the lazy updates of a parent to a child covering length elements: adds add to every
+     * element, then clamps them to [low, high], the minimum and maximum of the parent.
+     */
+    void PushTo(int node, int length, Sum add, T low, T high);
+
+    // Recursive implementations of the public methods, on a node covering [lo, hi)
+    void ChMin(int node, int lo, int hi, int left, int right, T value);
+    void ChMax(int node, int lo, int hi, int left, int right, T value);
+    void Add(int node, int lo, int hi, int left, int right, T value);
+    Sum QuerySum(int node, int lo, int hi, int left, int right);
+    T QueryMax(int node, int lo, int hi, int left, int right);
+    T QueryMin(int node, int lo, int hi, int left, int right);
+};
+
+// Include the implementation file for templates
+#include "SegmentTreeBeats.cpp"
+
+#endif // SEGMENTTREEBEATS_HPP
@@ -7,24 +7,106 @@
 template <typename T, auto op>
 template <Iterator Iter>
 SparseTable<T, op>::SparseTable(Iter start, Iter end)
+    : SparseTable(start, end, 1) {}
+
+// Constructor from a range of elements with a parallel build
+template <typename T, auto op>
+template <Iterator Iter>
+SparseTable<T, op>::SparseTable(Iter start, Iter end, int threads)
     : size_(std::distance(start, end)), LOG_(32 - __builtin_clz(size_)),
-      data_(LOG_, std::vector<T>(size_)) {
+      data_(Offset(LOG_)) {
+    if (threads <= 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
     // Copy the input elements into the first level of the sparse table
-    std::copy(start, end, data_[0].begin());
+    if constexpr (std::random_access_iterator<Iter>) {
+        ParallelFor(0, size_, threads, [&](int j) { data_[j] = start[j]; });
+    } else {
+        std::copy(start, end, data_.begin());
+    }
 
-    // Build the sparse table
+    // Build the sparse table, the entries of a level only depend on the previous level
     for (int i = 0; i < LOG_ - 1; ++i) {
-        for (int j = 0; j + (1 << i) < size_; ++j) {
-            data_[i + 1][j] = op(data_[i][j], data_[i][j + (1 << i)]);
-        }
+        T* prev = data_.data() + Offset(i);
+        T* next = data_.data() + Offset(i + 1);
+        ParallelFor(0, size_ - (2 << i) + 1, threads,
+                    [&](int j) { next[j] = op(prev[j], prev[j + (1 << i)]); });
     }
 }
 
 // Query function
 template <typename T, auto op>
-T SparseTable<T, op>::Query(int left, int right) {
+T SparseTable<T, op>::Query(int left, int right) const {
     int block = 31 - __builtin_clz(right - left);       // Calculate the largest power of 2 <= (right - left)
-    return op(data_[block][left], data_[block][right - (1 << block)]);
+    const T* level = Data() + Offset(block);
+    return op(level[left], level[right - (1 << block)]);
+}
+
+// Save to a file
+template <typename T, auto op>
+void SparseTable<T, op>::SaveTo(const std::string& path) const requires std::is_trivially_copyable_v<T> {
+    Snapshot::Save(path, Snapshot::KIND_SPARSE_TABLE, {static_cast<std::uint64_t>(size_)},
+                   {{Data(), Offset(LOG_), sizeof(T)}});
+}
+
+// Map from a file
+template <typename T, auto op>
+SparseTable<T, op> SparseTable<T, op>::MapFrom(const std::string& path) requires std::is_trivially_copyable_v<T> {
+    return SparseTable(Snapshot::Map(path, Snapshot::KIND_SPARSE_TABLE));
+}
+
+// Constructor over a mapped snapshot
+template <typename T, auto op>
+SparseTable<T, op>::SparseTable(Snapshot snapshot)
+    : size_(static_cast<int>(snapshot.Field(0))), LOG_(32 - __builtin_clz(size_)),
+      snapshot_(std::move(snapshot)) {
+    std::span<const T> levels = snapshot_.Data<T>(0);
+    if (levels.size() != Offset(LOG_)) {
+        throw std::runtime_error("SparseTable: the snapshot doesn't hold all the levels");
+    }
+    mapped_ = levels.data();
+}
+
+// Built or mapped levels
+template <typename T, auto op>
+const T* SparseTable<T, op>::Data() const {
+    return mapped_ != nullptr ? mapped_ : data_.data();
+}
+
+// Start of a level in the flat storage
+template <typename T, auto op>
+std::size_t SparseTable<T, op>::Offset(int level) const {
+    // Sum of (size_ - 2^k + 1) over the levels k < level, past the range of int for large tables
+    return static_cast<std::size_t>(level) * (size_ + 1) - (std::size_t{1} << level) + 1;
+}
+
+// Run body(i) over [begin, end) on several threads
+template <typename T, auto op>
+template <typename F>
+void SparseTable<T, op>::ParallelFor(int begin, int end, int threads, F body) {
+    // Small ranges are not worth starting threads for
+    threads = std::min(threads, (end - begin) / PARALLEL_GRAIN);
+    if (threads <= 1) {
+        for (int i = begin; i < end; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    int chunk = (end - begin + threads - 1) / threads;
+    for (int lo = begin; lo < end; lo += chunk) {
+        int hi = std::min(end, lo + chunk);
+        workers.emplace_back([lo, hi, &body] {
+            for (int i = lo; i < hi; ++i) {
+                body(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
 }
 
 #endif // SPARSETABLE_CPP
@@ -3,8 +3,15 @@
 
 #include <algorithm>  // For std::copy
 #include <cassert>    // For assert
+#include <cstddef>    // For std::size_t
 #include <functional> // For std::invoke
+#include <iterator>   // For std::random_access_iterator
+#include <string>     // For std::string
+#include <thread>     // For std::thread
+#include <type_traits> // For std::is_trivially_copyable_v
+#include <utility>    // For std::move
 #include <vector>     // For std::vector
+#include "../../Utilities/Snapshot/Snapshot.hpp"
 
 // Concept to ensure the type is an iterator
 template <typename Iter>
@@ -41,19 +48,86 @@ public:
     template <Iterator Iter>
     explicit SparseTable(Iter start, Iter end);
 
+    /**
+     * Constructs a SparseTable from a range of elements, building each level with several threads.
+     * The result is identical to the serial build.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     * @param threads The number of threads to use (0 for one per hardware thread).
+     */
+    template <Iterator Iter>
+    explicit SparseTable(Iter start, Iter end, int threads);
+
     /**
      * Queries the range [left, right).
+     * Read only, so any number of threads can query the same table at once.
      *
      * @param left The left index (inclusive).
      * @param right The right index (exclusive).
      * @return The result of the operation over the range.
      */
-    T Query(int left, int right);
+    T Query(int left, int right) const;
+
+    /**
+     * Saves the table to a file, to be mapped later with MapFrom.
+     *
+     * @param path The path of the file, replaced if it exists.
+     * @throws std::runtime_error if the file can't be written.
+     */
+    void SaveTo(const std::string& path) const requires std::is_trivially_copyable_v<T>;
+
+    /**
+     * Maps a table saved with SaveTo in memory. It is queried in place: nothing is rebuilt or copied,
+     * and processes mapping the same file share its pages.
+     *
+     * @param path The path of the file.
+     * @return The table, which keeps the file mapped as long as it (or a copy of it) exists.
+     * @throws std::runtime_error if the file isn't a SparseTable snapshot with elements of the size of T.
+     */
+    static SparseTable MapFrom(const std::string& path) requires std::is_trivially_copyable_v<T>;
 
 private:
+    static constexpr int PARALLEL_GRAIN = 1 << 14; // Minimum number of entries per thread in a parallel build
+
     int size_;                  // Number of elements in the table
-    int LOG_;                   // Log2 of the size (for block size calculation)
-    std::vector<std::vector<T>> data_; // The underlying sparse table data
+    int LOG_;                   // Number of levels in the table
+    std::vector<T> data_;       // All levels stored back to back, level k holds size_ - 2^k + 1 entries
+    Snapshot snapshot_;         // The mapped file, if the table was mapped instead of built
+    const T* mapped_ = nullptr; // The levels in the mapped file (data_ is empty then)
+
+    /**
+     * Constructs a SparseTable over the levels of a mapped snapshot.
+     *
+     * @param snapshot The mapped snapshot.
+     */
+    explicit SparseTable(Snapshot snapshot);
+
+    /**
+     * Gets the levels, whether they were built or mapped.
+     *
+     * @return The first entry of the first level.
+     */
+    const T* Data() const;
+
+    /**
+     * Computes where a level starts in `data_`.
+     *
+     * @param level The level, covering blocks of 2^level elements.
+     * @return The index of the first entry of the level.
+     */
+    std::size_t Offset(int level) const;
+
+    /**
+     * Runs body(i) for every i in [begin, end), split into contiguous chunks over several threads.
+     *
+     * @param begin The first index.
+     * @param end One past the last index.
+     * @param threads The maximum number of threads to use.
+     * @param body The function to run for each index.
+     */
+    template <typename F>
+    static void ParallelFor(int begin, int end, int threads, F body);
 };
 
 // Include the implementation file for templates
@@ -0,0 +1,170 @@
+#ifndef SQRTTREE_CPP
+#define SQRTTREE_CPP
+
+#include "SqrtTree.hpp"
+
+// Constructor from a range of elements
+template <typename T, auto op>
+template <std::input_iterator Iter>
+SqrtTree<T, op>::SqrtTree(Iter start, Iter end)
+    : values_(start, end) {
+    size_ = static_cast<int>(values_.size());
+    lg_ = size_ > 1 ? std::bit_width(static_cast<unsigned>(size_ - 1)) : 0;
+
+    // Layer k splits blocks of 2^layers_[k] elements into blocks of about the square root of that,
+    // until the blocks have at most 2 elements, which are queried directly
+    onLayer_.assign(lg_ + 1, 0);
+    for (int log = lg_; log > 1; log = (log + 1) / 2) {
+        onLayer_[log] = static_cast<int>(layers_.size());
+        layers_.push_back(log);
+    }
+    for (int log = lg_ - 1; log >= 0; --log) {
+        onLayer_[log] = std::max(onLayer_[log], onLayer_[log + 1]);
+    }
+
+    int blockLog = (lg_ + 1) / 2;
+    int blockSize = 1 << blockLog;
+    indexSize_ = (size_ + blockSize - 1) >> blockLog;
+    values_.resize(size_ + indexSize_);
+    stride_ = size_ + indexSize_;
+    betweenStride_ = (std::size_t{1} << lg_) + blockSize;
+    prefix_.resize(layers_.size() * stride_);
+    suffix_.resize(layers_.size() * stride_);
+    between_.resize(layers_.empty() ? 0 : (layers_.size() - 1) * betweenStride_);
+    Build(0, 0, size_, 0);
+}
+
+// Query function
+template <typename T, auto op>
+T SqrtTree<T, op>::Query(int left, int right) const {
+    return Query(left, right, 0, 0);
+}
+
+// Update function
+template <typename T, auto op>
+void SqrtTree<T, op>::Update(int pos, T value) {
+    values_[pos] = value;
+    Update(0, 0, size_, 0, pos);
+}
+
+// Prefix and suffix results of one block
+template <typename T, auto op>
+void SqrtTree<T, op>::BuildBlock(int layer, int left, int right) {
+    T* prefix = prefix_.data() + layer * stride_;
+    T* suffix = suffix_.data() + layer * stride_;
+    prefix[left] = values_[left];
+    for (int i = left + 1; i < right; ++i) {
+        prefix[i] = op(prefix[i - 1], values_[i]);
+    }
+    suffix[right - 1] = values_[right - 1];
+    for (int i = right - 2; i >= left; --i) {
+        suffix[i] = op(values_[i], suffix[i + 1]);
+    }
+}
+
+// Results between every pair of blocks
+template <typename T, auto op>
+void SqrtTree<T, op>::BuildBetween(int layer, int lBound, int rBound, int betweenOffset) {
+    int blockLog = (layers_[layer] + 1) / 2;
+    int countLog = layers_[layer] / 2;
+    int count = (rBound - lBound + (1 << blockLog) - 1) >> blockLog;
+    const T* suffix = suffix_.data() + layer * stride_;
+    T* between = between_.data() + (layer - 1) * betweenStride_ + betweenOffset + lBound;
+
+    // The result of blocks i to j is the result of blocks i to j - 1, then the whole block j
+    for (int i = 0; i < count; ++i) {
+        T result = suffix[lBound + (i << blockLog)];
+        between[(i << countLog) + i] = result;
+        for (int j = i + 1; j < count; ++j) {
+            result = op(result, suffix[lBound + (j << blockLog)]);
+            between[(i << countLog) + j] = result;
+        }
+    }
+}
+
+// Build the index over the top-level blocks
+template <typename T, auto op>
+void SqrtTree<T, op>::BuildBetweenZero() {
+    int blockLog = (lg_ + 1) / 2;
+    for (int i = 0; i < indexSize_; ++i) {
+        values_[size_ + i] = suffix_[i << blockLog];
+    }
+    Build(1, size_, size_ + indexSize_, (1 << lg_) - size_);
+}
+
+// Update the index after a change in one top-level block
+template <typename T, auto op>
+void SqrtTree<T, op>::UpdateBetweenZero(int block) {
+    int blockLog = (lg_ + 1) / 2;
+    values_[size_ + block] = suffix_[block << blockLog];
+    Update(1, size_, size_ + indexSize_, (1 << lg_) - size_, size_ + block);
+}
+
+// Build a layer recursively
+template <typename T, auto op>
+void SqrtTree<T, op>::Build(int layer, int lBound, int rBound, int betweenOffset) {
+    if (layer >= static_cast<int>(layers_.size())) {
+        return;
+    }
+    int blockSize = 1 << ((layers_[layer] + 1) / 2);
+    for (int left = lBound; left < rBound; left += blockSize) {
+        int right = std::min(left + blockSize, rBound);
+        BuildBlock(layer, left, right);
+        Build(layer + 1, left, right, betweenOffset);
+    }
+    if (layer == 0) {
+        BuildBetweenZero();
+    } else {
+        BuildBetween(layer, lBound, rBound, betweenOffset);
+    }
+}
+
+// Rebuild the blocks containing one position
+template <typename T, auto op>
+void SqrtTree<T, op>::Update(int layer, int lBound, int rBound, int betweenOffset, int pos) {
+    if (layer >= static_cast<int>(layers_.size())) {
+        return;
+    }
+    int blockLog = (layers_[layer] + 1) / 2;
+    int block = (pos - lBound) >> blockLog;
+    int left = lBound + (block << blockLog);
+    int right = std::min(left + (1 << blockLog), rBound);
+    BuildBlock(layer, left, right);
+    if (layer == 0) {
+        UpdateBetweenZero(block);
+    } else {
+        BuildBetween(layer, lBound, rBound, betweenOffset);
+    }
+    Update(layer + 1, left, right, betweenOffset, pos);
+}
+
+// Query in the tree over the elements (base 0) or over the index (base size_)
+template <typename T, auto op>
+T SqrtTree<T, op>::Query(int left, int right, int betweenOffset, int base) const {
+    if (left == right) {
+        return values_[left];
+    }
+    if (left + 1 == right) {
+        return op(values_[left], values_[right]);
+    }
+
+    // The layer whose blocks split left and right apart, as in a Disjoint Sparse Table
+    int layer = onLayer_[std::bit_width(static_cast<unsigned>((left - base) ^ (right - base)))];
+    int blockLog = (layers_[layer] + 1) / 2;
+    int countLog = layers_[layer] / 2;
+    int lBound = (((left - base) >> layers_[layer]) << layers_[layer]) + base;
+    int lBlock = ((left - lBound) >> blockLog) + 1;
+    int rBlock = ((right - lBound) >> blockLog) - 1;
+
+    // Suffix of the block of left, then the whole blocks in between, then prefix of the block of right
+    T result = suffix_[layer * stride_ + left];
+    if (lBlock <= rBlock) {
+        T middle = layer == 0
+            ? Query(size_ + lBlock, size_ + rBlock, (1 << lg_) - size_, size_)
+            : between_[(layer - 1) * betweenStride_ + betweenOffset + lBound + (lBlock << countLog) + rBlock];
+        result = op(result, middle);
+    }
+    return op(result, prefix_[layer * stride_ + right]);
+}
+
+#endif // SQRTTREE_CPP
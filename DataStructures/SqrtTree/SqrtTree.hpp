@@ -0,0 +1,114 @@
+#ifndef SQRTTREE_HPP
+#define SQRTTREE_HPP
+
+#include <algorithm>   // For std::min, std::max
+#include <bit>         // For std::bit_width
+#include <cstddef>     // For std::size_t
+#include <iterator>    // For std::input_iterator
+#include <type_traits> // For std::is_invocable_r_v
+#include <vector>      // For std::vector
+
+/**
+ * Sqrt Tree implementation for O(1) range queries with point updates.
+ * Supports any associative operation (sum, product, matrix product, ...), like a Disjoint Sparse Table.
+ *
+ * The array is split into blocks of about sqrt(N) elements, which store their prefix and suffix results,
+ * and the results between every pair of blocks. Blocks are split again the same way, recursively, so there
+ * are O(log log N) layers. The results between the top-level blocks live in a smaller Sqrt Tree over one
+ * value per block (the "index"), so that updates stay O(sqrt N).
+ *
+ * @tparam T The type of elements stored in the tree.
+ * @tparam op The operation function (e.g., sum, product, xor).
+ */
+template <typename T, auto op>
+class SqrtTree {
+    // Helper to check if `op` is callable with T or T&
+    template <typename F, typename A, typename B>
+    static constexpr bool IsOpCallable =
+        std::is_invocable_r_v<T, F, A, B> || std::is_invocable_r_v<T, F, A&, B> ||
+        std::is_invocable_r_v<T, F, A, B&> || std::is_invocable_r_v<T, F, A&, B&>;
+
+    // Ensure `op` is valid
+    static_assert(IsOpCallable<decltype(op), T, T>,
+                  "`op` must be callable with T or T& as arguments");
+
+public:
+    /**
+     * Constructs a SqrtTree from a range of elements.
+     *
+     * @param start Iterator to the start of the range.
+     * @param end Iterator to the end of the range.
+     */
+    template <std::input_iterator Iter>
+    explicit SqrtTree(Iter start, Iter end);
+
+    /**
+     * Queries the range [left, right].
+     *
+     * @param left The left index (inclusive).
+     * @param right The right index (inclusive).
+     * @return The result of the operation over the range.
+     */
+    T Query(int left, int right) const;
+
+    /**
+     * Sets the element at a position to a new value.
+     *
+     * @param pos The position to update.
+     * @param value The new value.
+     */
+    void Update(int pos, T value);
+
+private:
+    int size_;                  // Number of elements in the tree
+    int lg_;                    // Log2 of the size, rounded up
+    int indexSize_;             // Number of top-level blocks, stored after the elements
+    std::size_t stride_;        // Length of each layer of prefix_ and suffix_
+    std::size_t betweenStride_; // Length of each layer of between_
+    std::vector<T> values_;     // The elements, followed by the suffix result of each top-level block
+    std::vector<int> layers_;   // Log2 of the length of the blocks split at each layer
+    std::vector<int> onLayer_;  // Layer that handles two positions whose highest differing bit is k
+    std::vector<T> prefix_;     // Prefix results within each block, all layers stored back to back
+    std::vector<T> suffix_;     // Suffix results within each block, all layers stored back to back
+    std::vector<T> between_;    // Results between every pair of blocks, for layers 1 and up
+
+    /**
+     * Computes the prefix and suffix results of the block [left, right) at a layer.
+     */
+    void BuildBlock(int layer, int left, int right);
+
+    /**
+     * Computes the results between every pair of blocks of [lBound, rBound) at a layer (at least 1).
+     */
+    void BuildBetween(int layer, int lBound, int rBound, int betweenOffset);
+
+    /**
+     * Builds the index: the Sqrt Tree over the suffix results of the top-level blocks.
+     */
+    void BuildBetweenZero();
+
+    /**
+     * Updates the index after a change in a top-level block.
+     */
+    void UpdateBetweenZero(int block);
+
+    /**
+     * Builds the blocks of [lBound, rBound) at a layer, and the layers below.
+     */
+    void Build(int layer, int lBound, int rBound, int betweenOffset);
+
+    /**
+     * Rebuilds the blocks containing pos at a layer and the layers below.
+     */
+    void Update(int layer, int lBound, int rBound, int betweenOffset, int pos);
+
+    /**
+     * Queries [left, right] in the Sqrt Tree whose elements start at base (0, or size_ for the index).
+     */
+    T Query(int left, int right, int betweenOffset, int base) const;
+};
+
+// Include the implementation file for templates
+#include "SqrtTree.cpp"
+
+#endif // SQRTTREE_HPP
@@ -0,0 +1,111 @@
+#ifndef SNAPSHOT_CPP
+#define SNAPSHOT_CPP
+
+#include "Snapshot.hpp"
+
+#include <algorithm>  // For std::copy
+#include <cstring>    // For std::memcmp
+#include <fstream>    // For std::ofstream
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap, munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+
+inline void Snapshot::Save(const std::string& path, std::uint32_t kind,
+                    std::initializer_list<std::uint64_t> fields, std::initializer_list<Array> arrays) {
+    if (fields.size() > MAX_FIELDS || arrays.size() > MAX_ARRAYS) {
+        throw std::runtime_error("Snapshot: too many fields or arrays");
+    }
+
+    // Lay out the arrays after the header, each one aligned
+    Header header{};
+    std::copy(MAGIC, MAGIC + 8, header.magic);
+    header.version = VERSION;
+    header.kind = kind;
+    std::copy(fields.begin(), fields.end(), header.fields);
+    std::uint64_t position = sizeof(Header);
+    int index = 0;
+    for (const Array& array : arrays) {
+        position = (position + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        header.arrays[index++] = {position, array.count, array.elementSize};
+        position += array.count * array.elementSize;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    index = 0;
+    for (const Array& array : arrays) {
+        // Zeros up to the start of the array
+        static constexpr char padding[ALIGNMENT] = {};
+        std::uint64_t written = static_cast<std::uint64_t>(file.tellp());
+        file.write(padding, static_cast<std::streamsize>(header.arrays[index++].offset - written));
+        file.write(static_cast<const char*>(array.data), static_cast<std::streamsize>(array.count * array.elementSize));
+    }
+    if (!file.flush()) {
+        throw std::runtime_error("Snapshot: can't write " + path);
+    }
+}
+
+inline Snapshot Snapshot::Map(const std::string& path, std::uint32_t kind) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Snapshot: can't open " + path);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+        close(fd);
+        throw std::runtime_error("Snapshot: " + path + " is too small to be a snapshot");
+    }
+
+    // The mapping stays valid after closing the file
+    std::size_t size = info.st_size;
+    void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Snapshot: can't map " + path);
+    }
+
+    Snapshot snapshot;
+    snapshot.mapping_ = std::shared_ptr<const std::byte>(static_cast<const std::byte*>(address),
+                                                         [size](const std::byte* p) { munmap(const_cast<std::byte*>(p), size); });
+    snapshot.size_ = size;
+
+    // Check the header, and that every array is inside the file
+    const Header& header = snapshot.GetHeader();
+    if (std::memcmp(header.magic, MAGIC, 8) != 0) {
+        throw std::runtime_error("Snapshot: " + path + " is not a snapshot");
+    }
+    if (header.version != VERSION) {
+        throw std::runtime_error("Snapshot: " + path + " has version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(VERSION));
+    }
+    if (header.kind != kind) {
+        throw std::runtime_error("Snapshot: " + path + " holds another kind of structure");
+    }
+    for (const auto& array : header.arrays) {
+        if (array.offset % ALIGNMENT != 0 || array.offset > size ||
+            (array.elementSize != 0 && array.count > (size - array.offset) / array.elementSize)) {
+            throw std::runtime_error("Snapshot: " + path + " is truncated or corrupted");
+        }
+    }
+    return snapshot;
+}
+
+inline std::uint64_t Snapshot::Field(int index) const {
+    return GetHeader().fields[index];
+}
+
+template <typename T>
+std::span<const T> Snapshot::Data(int index) const {
+    const auto& array = GetHeader().arrays[index];
+    if (array.elementSize != sizeof(T)) {
+        throw std::runtime_error("Snapshot: the stored elements don't have the size of the requested type");
+    }
+    return {reinterpret_cast<const T*>(mapping_.get() + array.offset), static_cast<std::size_t>(array.count)};
+}
+
+inline const Snapshot::Header& Snapshot::GetHeader() const {
+    return *reinterpret_cast<const Header*>(mapping_.get());
+}
+
+#endif // SNAPSHOT_CPP
@@ -0,0 +1,101 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstddef>          // For std::byte, std::size_t
+#include <cstdint>          // For std::uint32_t, std::uint64_t
+#include <initializer_list> // For std::initializer_list
+#include <memory>           // For std::shared_ptr
+#include <span>             // For std::span
+#include <stdexcept>        // For std::runtime_error
+#include <string>           // For std::string
+
+/**
+ * Binary snapshot of a static data structure: a versioned header, followed by flat arrays.
+ * Saved with Save, and opened with Map, which maps the file in memory (read only, shared)
+ * so that the arrays are used in place: nothing is copied, and processes mapping the same
+ * file share the same pages of the page cache.
+ *
+ * The arrays are stored as raw bytes, so a snapshot can only be read back on a machine
+ * with the same byte order and the same layout for the stored types.
+ */
+class Snapshot {
+public:
+    static constexpr std::uint32_t VERSION = 1; // Bumped whenever the file format changes
+
+    // Which structure wrote a snapshot
+    static constexpr std::uint32_t KIND_SPARSE_TABLE = 1;
+    static constexpr std::uint32_t KIND_DISJOINT_SPARSE_TABLE = 2;
+    static constexpr std::uint32_t KIND_LCA = 3;
+
+    static constexpr int MAX_FIELDS = 4; // Number of integers stored in the header
+    static constexpr int MAX_ARRAYS = 4; // Number of arrays in a snapshot
+    static constexpr std::size_t ALIGNMENT = 64; // Every array starts at a multiple of this in the file
+
+    // One array to save
+    struct Array {
+        const void* data;          // First element
+        std::uint64_t count;       // Number of elements
+        std::uint64_t elementSize; // Size of an element in bytes
+    };
+
+    /**
+     * Saves a snapshot to a file, replacing it if it exists
+     * @param path Path of the file
+     * @param kind Which structure is saved (one of the KIND_ constants)
+     * @param fields Integers describing the structure (at most MAX_FIELDS)
+     * @param arrays Arrays of the structure (at most MAX_ARRAYS)
+     * @throws std::runtime_error if the file can't be written
+     */
+    static void Save(const std::string& path, std::uint32_t kind,
+                     std::initializer_list<std::uint64_t> fields, std::initializer_list<Array> arrays);
+
+    /**
+     * Maps a snapshot saved by Save in memory
+     * @param path Path of the file
+     * @param kind Which structure the snapshot must hold
+     * @return The mapped snapshot, which stays mapped as long as a copy of it exists
+     * @throws std::runtime_error if the file can't be mapped, or isn't a valid snapshot of this kind and version
+     */
+    static Snapshot Map(const std::string& path, std::uint32_t kind);
+
+    /**
+     * Gets an integer stored in the header
+     * @param index Index of the field, in the order given to Save
+     * @return The value of the field
+     */
+    std::uint64_t Field(int index) const;
+
+    /**
+     * Gets an array of the snapshot, in place
+     * @param index Index of the array, in the order given to Save
+     * @return The elements of the array
+     * @throws std::runtime_error if the elements of the array don't have the size of T
+     */
+    template <typename T>
+    std::span<const T> Data(int index) const;
+
+private:
+    static constexpr char MAGIC[8] = {'C', 'P', 'S', 'N', 'A', 'P', 0, 0}; // First bytes of every snapshot
+
+    struct Header {
+        char magic[8];                  // MAGIC
+        std::uint32_t version;          // VERSION when the snapshot was saved
+        std::uint32_t kind;             // Which structure was saved
+        std::uint64_t fields[MAX_FIELDS];
+        struct {
+            std::uint64_t offset;       // Position of the first element in the file
+            std::uint64_t count;        // Number of elements
+            std::uint64_t elementSize;  // Size of an element in bytes
+        } arrays[MAX_ARRAYS];
+    };
+
+    std::shared_ptr<const std::byte> mapping_; // Start of the mapped file, unmapped with the last copy
+    std::size_t size_ = 0;                     // Size of the mapped file in bytes
+
+    const Header& GetHeader() const;
+};
+
+// Include the implementation file for templates
+#include "Snapshot.cpp"
+
+#endif // SNAPSHOT_HPP
@@ -0,0 +1,90 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <cstdint> // For std::uint64_t
+
+/**
+ * Work done by the queries and updates of a structure, as counted by CountStats.
+ * Building a structure is not counted.
+ */
+struct OperationStats {
+    std::uint64_t queries = 0;       // Calls to query methods (Query, MaxRight, MinLeft, QueryPath, ...)
+    std::uint64_t updates = 0;       // Calls to update methods (Update, UpdatePath, ...)
+    std::uint64_t nodesVisited = 0;  // Tree nodes read or written (blocks of nodes for wide layouts)
+    std::uint64_t opCalls = 0;       // Invocations of `op`
+    std::uint64_t propagations = 0;  // Lazy updates pushed from a node to its children
+    std::uint64_t allocations = 0;   // Nodes created (DynamicSegmentTree)
+    std::uint64_t chainsCrossed = 0; // Heavy chains crossed by path operations (HLD)
+
+    // Adds the counters of another structure
+    OperationStats& operator+=(const OperationStats& other) {
+        queries += other.queries;
+        updates += other.updates;
+        nodesVisited += other.nodesVisited;
+        opCalls += other.opCalls;
+        propagations += other.propagations;
+        allocations += other.allocations;
+        chainsCrossed += other.chainsCrossed;
+        return *this;
+    }
+
+    /**
+     * Calls f(name, value) for every counter, e.g. to export them as metrics
+     * @param f Callable with a const char* and a std::uint64_t
+     */
+    template <typename F>
+    void ForEach(F f) const {
+        f("queries", queries);
+        f("updates", updates);
+        f("nodes_visited", nodesVisited);
+        f("op_calls", opCalls);
+        f("propagations", propagations);
+        f("allocations", allocations);
+        f("chains_crossed", chainsCrossed);
+    }
+};
+
+/**
+ * Statistics policy that counts nothing, the default of every instrumented structure.
+ * All of its methods are empty and it has no members, so with [[no_unique_address]] it costs
+ * neither time nor memory.
+ */
+struct NoStats {
+    static constexpr bool ENABLED = false;
+
+    void CountQuery() const {}
+    void CountUpdate() const {}
+    void CountNodes(std::uint64_t = 1) const {}
+    void CountOps(std::uint64_t = 1) const {}
+    void CountPropagation() const {}
+    void CountAllocation() const {}
+    void CountChain() const {}
+
+    OperationStats Get() const { return {}; }
+    void Reset() {}
+};
+
+/**
+ * Statistics policy that counts the work of every query and update of its structure.
+ * The counters are plain integers owned by the structure: like the structure itself, they must not be
+ * updated from several threads at once. They can be counted from const methods.
+ */
+struct CountStats {
+    static constexpr bool ENABLED = true;
+
+    void CountQuery() const { ++stats.queries; }
+    void CountUpdate() const { ++stats.updates; }
+    void CountNodes(std::uint64_t count = 1) const { stats.nodesVisited += count; }
+    void CountOps(std::uint64_t count = 1) const { stats.opCalls += count; }
+    void CountPropagation() const { ++stats.propagations; }
+    void CountAllocation() const { ++stats.allocations; }
+    void CountChain() const { ++stats.chainsCrossed; }
+
+    OperationStats Get() const { return stats; }
+    void Reset() { stats = {}; }
+
+private:
+    mutable OperationStats stats; // Counters, updated by const queries too
+};
+
+#endif // STATS_HPP
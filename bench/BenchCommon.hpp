@@ -0,0 +1,117 @@
+#ifndef BENCHCOMMON_HPP
+#define BENCHCOMMON_HPP
+
+#include <algorithm> // For std::min, std::swap
+#include <cstdint>   // For std::uint64_t
+#include <random>    // For std::mt19937_64
+#include <utility>   // For std::pair
+#include <vector>    // For std::vector
+#include <benchmark/benchmark.h>
+
+// Largest n, set by CP_TEMPLATES_BENCH_MAX_N in CMake
+#ifndef CP_BENCH_MAX_N
+#define CP_BENCH_MAX_N 100000000LL
+#endif
+
+namespace bench {
+
+constexpr long long MAX_N = CP_BENCH_MAX_N;
+
+// Structures with O(N log N) memory, or many bytes per element, stop here so that they fit in a few GB
+constexpr long long LARGE_MEMORY_N = 10000000;
+
+// Operations generated before timing, the timed loops cycle through them
+constexpr int OPERATIONS = 1 << 16;
+
+constexpr std::uint64_t SEED = 42; // Fixed so that every run sees the same data
+
+// Registers n = 1e3, 1e4, ... up to min(LIMIT, MAX_N)
+template <long long LIMIT = MAX_N>
+void Sizes(benchmark::internal::Benchmark* b) {
+    for (long long n = 1000; n <= std::min(LIMIT, MAX_N); n *= 10) {
+        b->Arg(n);
+    }
+}
+
+// Random values in [0, bound)
+inline std::vector<long long> RandomValues(long long n, long long bound = 1000000000) {
+    std::mt19937_64 rng(SEED);
+    std::vector<long long> values(n);
+    for (auto& value : values) {
+        value = static_cast<long long>(rng() % bound);
+    }
+    return values;
+}
+
+// Random non-empty half-open ranges [left, right) of [0, n)
+inline std::vector<std::pair<int, int>> RandomRanges(int n) {
+    std::mt19937_64 rng(SEED + 1);
+    std::vector<std::pair<int, int>> ranges(OPERATIONS);
+    for (auto& [left, right] : ranges) {
+        left = static_cast<int>(rng() % n);
+        right = static_cast<int>(rng() % n);
+        if (left > right) std::swap(left, right);
+        ++right;
+    }
+    return ranges;
+}
+
+// Half-open ranges [i, i + 16) sweeping [0, n) from left to right, so consecutive queries touch nearby memory
+inline std::vector<std::pair<int, int>> SequentialRanges(int n) {
+    std::vector<std::pair<int, int>> ranges(OPERATIONS);
+    int length = std::min(n, 16);
+    for (int i = 0; i < OPERATIONS; ++i) {
+        int left = static_cast<int>((static_cast<long long>(i) * length) % (n - length + 1));
+        ranges[i] = {left, left + length};
+    }
+    return ranges;
+}
+
+// Random positions in [0, n), paired with random values
+inline std::vector<std::pair<int, long long>> RandomPoints(int n) {
+    std::mt19937_64 rng(SEED + 2);
+    std::vector<std::pair<int, long long>> points(OPERATIONS);
+    for (auto& [pos, value] : points) {
+        pos = static_cast<int>(rng() % n);
+        value = static_cast<long long>(rng() % 1000);
+    }
+    return points;
+}
+
+// Random recursive tree on nodes first to first + n - 1: node i gets a random parent among the nodes before it
+inline std::vector<std::vector<int>> RandomTree(int n, int first = 0) {
+    std::mt19937_64 rng(SEED + 3);
+    std::vector<std::vector<int>> adj(n + first);
+    for (int i = 1; i < n; ++i) {
+        int parent = static_cast<int>(rng() % i);
+        adj[first + i].push_back(first + parent);
+        adj[first + parent].push_back(first + i);
+    }
+    return adj;
+}
+
+// Random pairs of nodes first to first + n - 1
+inline std::vector<std::pair<int, int>> RandomPairs(int n, int first = 0) {
+    std::mt19937_64 rng(SEED + 4);
+    std::vector<std::pair<int, int>> pairs(OPERATIONS);
+    for (auto& [u, v] : pairs) {
+        u = first + static_cast<int>(rng() % n);
+        v = first + static_cast<int>(rng() % n);
+    }
+    return pairs;
+}
+
+// Runs body(operation) once per iteration, cycling through the operations, and reports operations per second
+template <typename Op, typename F>
+void RunOperations(benchmark::State& state, const std::vector<Op>& operations, F body) {
+    std::size_t i = 0;
+    for (auto _ : state) {
+        body(operations[i]);
+        i = (i + 1) & (OPERATIONS - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace bench
+
+#endif // BENCHCOMMON_HPP
@@ -0,0 +1,60 @@
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/CompressedSegmentTree/CompressedSegmentTree.hpp"
+
+namespace {
+
+// Range add, range min, the same operations as the DynamicSegmentTree benchmarks
+constexpr auto Min = [](long long a, long long b) { return std::min(a, b); };
+constexpr auto Add = [](long long value, long long delta) { return value + delta; };
+constexpr auto Compose = [](long long& lazy, long long& value, long long delta, long long&, long long&) {
+    lazy += delta;
+    value += delta;
+};
+
+using Tree = CompressedSegmentTree<long long, long long, Min, Add, Compose>;
+
+// The OPERATIONS random ranges of [0, n), inclusive, which every benchmark queries or updates
+std::vector<std::pair<long long, long long>> Ranges(int n) {
+    std::vector<std::pair<long long, long long>> ranges;
+    for (auto [left, right] : bench::RandomRanges(n)) {
+        ranges.emplace_back(left, right - 1);
+    }
+    return ranges;
+}
+
+// Compressing the ranges and building the tree over the leaves
+void BM_Build(benchmark::State& state) {
+    int n = state.range(0);
+    auto ranges = Ranges(n);
+    for (auto _ : state) {
+        Tree tree(0, n - 1, ranges, 0, 0);
+        benchmark::DoNotOptimize(tree.Leaves());
+    }
+    state.SetItemsProcessed(state.iterations() * ranges.size());
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    auto ranges = Ranges(state.range(0));
+    Tree tree(0, state.range(0) - 1, ranges, 0, 0);
+    for (auto [left, right] : ranges) {
+        tree.Update(left, right, 1);
+    }
+    bench::RunOperations(state, ranges, [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+void BM_Update(benchmark::State& state) {
+    auto ranges = Ranges(state.range(0));
+    Tree tree(0, state.range(0) - 1, ranges, 0, 0);
+    bench::RunOperations(state, ranges, [&](auto range) { tree.Update(range.first, range.second, 1); });
+    benchmark::DoNotOptimize(tree.Query(0, state.range(0) - 1));
+}
+
+} // namespace
+
+// The tree only depends on the OPERATIONS ranges, so n only spreads them out. There is no sequential benchmark,
+// since the sequential ranges of the other benchmarks would be different ranges from the ones the tree is built for
+BENCHMARK(BM_Build)->Apply(bench::Sizes<>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<>);
+BENCHMARK(BM_Update)->Apply(bench::Sizes<>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+#include <atomic> // For std::atomic
+#include <thread> // For std::thread
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/ConcurrentSegmentTree/ConcurrentSegmentTree.hpp"
+
+namespace {
+
+constexpr auto Sum = [](long long a, long long b) { return a + b; };
+constexpr auto Add = [](long long value, long long delta) { return value + delta; };
+
+using Tree = ConcurrentSegmentTree<long long, long long, Sum, Add>;
+
+void BM_Build(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    for (auto _ : state) {
+        Tree tree(values.begin(), values.end(), 0);
+        benchmark::DoNotOptimize(tree[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+void BM_QuerySequential(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::SequentialRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+void BM_Update(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::RandomPoints(state.range(0)),
+                         [&](auto point) { tree.Update(point.first, point.second); });
+    benchmark::DoNotOptimize(tree[0]);
+}
+
+// Random queries while another thread updates random points without pause, so queries have to retry
+void BM_QueryRandomWithWriter(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree tree(values.begin(), values.end(), 0);
+    std::atomic<bool> stop = false;
+    std::thread writer([&] {
+        auto points = bench::RandomPoints(state.range(0));
+        for (std::size_t i = 0; !stop.load(std::memory_order_relaxed); i = (i + 1) & (bench::OPERATIONS - 1)) {
+            tree.Update(points[i].first, points[i].second);
+        }
+    });
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+    stop = true;
+    writer.join();
+}
+
+} // namespace
+
+BENCHMARK(BM_Build)->Apply(bench::Sizes<>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<>);
+BENCHMARK(BM_Update)->Apply(bench::Sizes<>);
+BENCHMARK(BM_QueryRandomWithWriter)->Apply(bench::Sizes<>)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/DisjointSetUnion/DisjointSetUnion.hpp"
+
+namespace {
+
+// count random pairs of [0, n)
+std::vector<std::pair<int, int>> RandomEdges(int n, long long count) {
+    std::mt19937_64 rng(bench::SEED + 5);
+    std::vector<std::pair<int, int>> edges(count);
+    for (auto& [u, v] : edges) {
+        u = static_cast<int>(rng() % n);
+        v = static_cast<int>(rng() % n);
+    }
+    return edges;
+}
+
+// n / 2 random joins, which leave a giant component and many small ones
+DisjointSetUnion HalfJoined(int n) {
+    DisjointSetUnion dsu(n);
+    for (auto [u, v] : RandomEdges(n, n / 2)) {
+        dsu.join(u, v);
+    }
+    return dsu;
+}
+
+// Construction followed by n random joins
+void BM_Build(benchmark::State& state) {
+    int n = state.range(0);
+    auto edges = RandomEdges(n, n);
+    for (auto _ : state) {
+        DisjointSetUnion dsu(n);
+        for (auto [u, v] : edges) {
+            dsu.join(u, v);
+        }
+        benchmark::DoNotOptimize(dsu.count());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    DisjointSetUnion dsu = HalfJoined(state.range(0));
+    bench::RunOperations(state, bench::RandomPairs(state.range(0)),
+                         [&](auto pair) { benchmark::DoNotOptimize(dsu.query(pair.first, pair.second)); });
+}
+
+void BM_QuerySequential(benchmark::State& state) {
+    DisjointSetUnion dsu = HalfJoined(state.range(0));
+    int n = state.range(0);
+    std::vector<std::pair<int, int>> pairs(bench::OPERATIONS);
+    for (int i = 0; i < bench::OPERATIONS; ++i) {
+        pairs[i] = {i % n, (i + 1) % n};
+    }
+    bench::RunOperations(state, pairs,
+                         [&](auto pair) { benchmark::DoNotOptimize(dsu.query(pair.first, pair.second)); });
+}
+
+void BM_Update(benchmark::State& state) {
+    DisjointSetUnion dsu = HalfJoined(state.range(0));
+    bench::RunOperations(state, bench::RandomPairs(state.range(0)),
+                         [&](auto pair) { dsu.join(pair.first, pair.second); });
+    benchmark::DoNotOptimize(dsu.count());
+}
+
+} // namespace
+
+BENCHMARK(BM_Build)->Apply(bench::Sizes<>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<>);
+BENCHMARK(BM_Update)->Apply(bench::Sizes<>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,46 @@
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/DisjointSparseTable/DisjointSparseTable.hpp"
+
+namespace {
+
+// 32-bit values keep the O(N log N) table within a few GB
+constexpr auto Xor = [](int a, int b) { return a ^ b; };
+
+using Table = DisjointSparseTable<int, Xor>;
+
+std::vector<int> Values(long long n) {
+    auto values = bench::RandomValues(n);
+    return std::vector<int>(values.begin(), values.end());
+}
+
+void BM_Build(benchmark::State& state) {
+    auto values = Values(state.range(0));
+    for (auto _ : state) {
+        Table table(values.begin(), values.end());
+        benchmark::DoNotOptimize(table.Query(0, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    auto values = Values(state.range(0));
+    Table table(values.begin(), values.end());
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(table.Query(range.first, range.second - 1)); });
+}
+
+void BM_QuerySequential(benchmark::State& state) {
+    auto values = Values(state.range(0));
+    Table table(values.begin(), values.end());
+    bench::RunOperations(state, bench::SequentialRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(table.Query(range.first, range.second - 1)); });
+}
+
+} // namespace
+
+// The table is static, so there is no Update benchmark
+BENCHMARK(BM_Build)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,63 @@
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/DynamicSegmentTree/DynamicSegmentTree.hpp"
+
+namespace {
+
+// Range add, range min
+constexpr auto Min = [](long long a, long long b) { return std::min(a, b); };
+constexpr auto Add = [](long long value, long long delta) { return value + delta; };
+constexpr auto Compose = [](long long& lazy, long long&, long long delta, long long&, long long&) { lazy += delta; };
+
+using Tree = DynamicSegmentTree<long long, long long, Min, Add, Compose>;
+
+// Tree over [0, n) holding OPERATIONS random range updates, the case the dynamic tree is made for
+Tree Sparse(int n) {
+    Tree tree(0, n - 1, 0, 0);
+    for (auto [left, right] : bench::RandomRanges(n)) {
+        tree.Update(left, right - 1, 1);
+    }
+    return tree;
+}
+
+// One point update per element, which creates every node of the tree
+void BM_Build(benchmark::State& state) {
+    int n = state.range(0);
+    auto values = bench::RandomValues(n);
+    for (auto _ : state) {
+        Tree tree(0, n - 1, 0, 0);
+        for (int i = 0; i < n; ++i) {
+            tree.Update(i, i, values[i]);
+        }
+        benchmark::DoNotOptimize(tree.Query(0, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    Tree tree = Sparse(state.range(0));
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second - 1)); });
+}
+
+void BM_QuerySequential(benchmark::State& state) {
+    Tree tree = Sparse(state.range(0));
+    bench::RunOperations(state, bench::SequentialRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second - 1)); });
+}
+
+void BM_Update(benchmark::State& state) {
+    Tree tree = Sparse(state.range(0));
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { tree.Update(range.first, range.second - 1, 1); });
+    benchmark::DoNotOptimize(tree.Query(0, 0));
+}
+
+} // namespace
+
+// A full tree has about 2N nodes, so the build stops at LARGE_MEMORY_N. The other benchmarks use a sparse tree
+BENCHMARK(BM_Build)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<>);
+BENCHMARK(BM_Update)->Apply(bench::Sizes<>);
+
+BENCHMARK_MAIN();
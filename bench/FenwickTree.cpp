@@ -0,0 +1,44 @@
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/FenwickTree/FenwickTree.hpp"
+
+namespace {
+
+void BM_Build(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    for (auto _ : state) {
+        FenwickTree<long long> tree(values.begin(), values.end(), 0);
+        benchmark::DoNotOptimize(tree.Query(0, 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    FenwickTree<long long> tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+void BM_QuerySequential(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    FenwickTree<long long> tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::SequentialRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+void BM_Update(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    FenwickTree<long long> tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::RandomPoints(state.range(0)),
+                         [&](auto point) { tree.Update(point.first, point.second); });
+    benchmark::DoNotOptimize(tree.Query(0, 1));
+}
+
+} // namespace
+
+BENCHMARK(BM_Build)->Apply(bench::Sizes<>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<>);
+BENCHMARK(BM_Update)->Apply(bench::Sizes<>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,60 @@
+#include "bench/BenchCommon.hpp"
+#include "Algorithms/HLD/HLD.hpp"
+
+namespace {
+
+// Path add, path min, on a Lazy Propagation Segment Tree
+constexpr auto Min = [](long long a, long long b) { return std::min(a, b); };
+constexpr auto Add = [](long long value, long long delta) { return value + delta; };
+
+using Tree = LazyHLD<long long, long long, Min, Add, Add>;
+
+constexpr long long INF = 1LL << 62;
+
+// The HLD uses 1-based nodes
+std::vector<std::vector<int>> Adjacency(int n) {
+    return bench::RandomTree(n, 1);
+}
+
+void BM_Build(benchmark::State& state) {
+    auto adj = Adjacency(state.range(0));
+    for (auto _ : state) {
+        Tree hld(adj, INF, 0);
+        benchmark::DoNotOptimize(hld.QuerySubtree(1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    Tree hld(Adjacency(state.range(0)), INF, 0);
+    bench::RunOperations(state, bench::RandomPairs(state.range(0), 1),
+                         [&](auto pair) { benchmark::DoNotOptimize(hld.QueryPath(pair.first, pair.second)); });
+}
+
+// Paths between consecutive nodes
+void BM_QuerySequential(benchmark::State& state) {
+    Tree hld(Adjacency(state.range(0)), INF, 0);
+    int n = state.range(0);
+    std::vector<std::pair<int, int>> pairs(bench::OPERATIONS);
+    for (int i = 0; i < bench::OPERATIONS; ++i) {
+        pairs[i] = {1 + i % n, 1 + (i + 1) % n};
+    }
+    bench::RunOperations(state, pairs,
+                         [&](auto pair) { benchmark::DoNotOptimize(hld.QueryPath(pair.first, pair.second)); });
+}
+
+void BM_Update(benchmark::State& state) {
+    Tree hld(Adjacency(state.range(0)), INF, 0);
+    bench::RunOperations(state, bench::RandomPairs(state.range(0), 1),
+                         [&](auto pair) { hld.UpdatePath(pair.first, pair.second, 1); });
+    benchmark::DoNotOptimize(hld.QuerySubtree(1));
+}
+
+} // namespace
+
+BENCHMARK(BM_Build)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+BENCHMARK(BM_Update)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+
+BENCHMARK_MAIN();
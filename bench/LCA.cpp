@@ -0,0 +1,55 @@
+#include "bench/BenchCommon.hpp"
+#include "Algorithms/LCA/LCA.hpp"
+
+namespace {
+
+LCA Preprocessed(int n) {
+    LCA lca(bench::RandomTree(n));
+    lca.preprocess();
+    return lca;
+}
+
+// Construction (which copies the adjacency list) and preprocessing
+void BM_Build(benchmark::State& state) {
+    auto adj = bench::RandomTree(state.range(0));
+    for (auto _ : state) {
+        LCA lca(adj);
+        lca.preprocess();
+        benchmark::DoNotOptimize(lca.findLCA(0, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    LCA lca = Preprocessed(state.range(0));
+    bench::RunOperations(state, bench::RandomPairs(state.range(0)),
+                         [&](auto pair) { benchmark::DoNotOptimize(lca.findLCA(pair.first, pair.second)); });
+}
+
+// Pairs of consecutive nodes, which are usually far apart in a random tree but close in memory
+void BM_QuerySequential(benchmark::State& state) {
+    LCA lca = Preprocessed(state.range(0));
+    int n = state.range(0);
+    std::vector<std::pair<int, int>> pairs(bench::OPERATIONS);
+    for (int i = 0; i < bench::OPERATIONS; ++i) {
+        pairs[i] = {i % n, (i + 1) % n};
+    }
+    bench::RunOperations(state, pairs,
+                         [&](auto pair) { benchmark::DoNotOptimize(lca.findLCA(pair.first, pair.second)); });
+}
+
+void BM_KthAncestor(benchmark::State& state) {
+    LCA lca = Preprocessed(state.range(0));
+    bench::RunOperations(state, bench::RandomPairs(state.range(0)),
+                         [&](auto pair) { benchmark::DoNotOptimize(lca.kthAncestor(pair.first, pair.second & 15)); });
+}
+
+} // namespace
+
+// The tree is static, so there is no Update benchmark
+BENCHMARK(BM_Build)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+BENCHMARK(BM_KthAncestor)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,51 @@
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/LazyPropSegtree/LazyPropSegtree.hpp"
+
+namespace {
+
+// Range add, range sum: the update needs the length of the range it is applied to
+constexpr auto Sum = [](long long a, long long b) { return a + b; };
+constexpr auto AddRange = [](long long value, long long delta, int length) { return value + delta * length; };
+constexpr auto Compose = [](long long older, long long newer) { return older + newer; };
+
+using Tree = LazyPropSegtree<long long, long long, Sum, AddRange, Compose>;
+
+void BM_Build(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    for (auto _ : state) {
+        Tree tree(values.begin(), values.end(), 0, 0);
+        benchmark::DoNotOptimize(tree.Query(0, 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_QueryRandom(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree tree(values.begin(), values.end(), 0, 0);
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+void BM_QuerySequential(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree tree(values.begin(), values.end(), 0, 0);
+    bench::RunOperations(state, bench::SequentialRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+void BM_Update(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree tree(values.begin(), values.end(), 0, 0);
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { tree.Update(range.first, range.second, 1); });
+    benchmark::DoNotOptimize(tree.Query(0, 1));
+}
+
+} // namespace
+
+BENCHMARK(BM_Build)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueryRandom)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+BENCHMARK(BM_QuerySequential)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+BENCHMARK(BM_Update)->Apply(bench::Sizes<bench::LARGE_MEMORY_N>);
+
+BENCHMARK_MAIN();
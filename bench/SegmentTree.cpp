@@ -0,0 +1,58 @@
+#include "bench/BenchCommon.hpp"
+#include "DataStructures/SegmentTree/SegmentTree.hpp"
+
+namespace {
+
+constexpr auto Sum = [](long long a, long long b) { return a + b; };
+constexpr auto Add = [](long long value, long long delta) { return value + delta; };
+
+template <typename Layout>
+using Tree = SegmentTree<long long, long long, Sum, Add, Layout>;
+
+template <typename Layout>
+void BM_Build(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    for (auto _ : state) {
+        Tree<Layout> tree(values.begin(), values.end(), 0);
+        benchmark::DoNotOptimize(tree[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Layout>
+void BM_QueryRandom(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree<Layout> tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::RandomRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+template <typename Layout>
+void BM_QuerySequential(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree<Layout> tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::SequentialRanges(state.range(0)),
+                         [&](auto range) { benchmark::DoNotOptimize(tree.Query(range.first, range.second)); });
+}
+
+template <typename Layout>
+void BM_Update(benchmark::State& state) {
+    auto values = bench::RandomValues(state.range(0));
+    Tree<Layout> tree(values.begin(), values.end(), 0);
+    bench::RunOperations(state, bench::RandomPoints(state.range(0)),
+                         [&](auto point) { tree.Update(point.first, point.second); });
+    benchmark::DoNotOptimize(tree[0]);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Build, BinaryLayout)->Apply(bench::Sizes<>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Build, WideLayout<8>)->Apply(bench::Sizes<>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_QueryRandom, BinaryLayout)->Apply(bench::Sizes<>);
+BENCHMARK_TEMPLATE(BM_QueryRandom, WideLayout<8>)->Apply(bench::Sizes<>);
+BENCHMARK_TEMPLATE(BM_QuerySequential, BinaryLayout)->Apply(bench::Sizes<>);
+BENCHMARK_TEMPLATE(BM_QuerySequential, WideLayout<8>)->Apply(bench::Sizes<>);
+BENCHMARK_TEMPLATE(BM_Update, BinaryLayout)->Apply(bench::Sizes<>);
+BENCHMARK_TEMPLATE(BM_Update, WideLayout<8>)->Apply(bench::Sizes<>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,4 @@
+// The link check only has to link: the other source files of link_check include the headers
+int main() {
+    return 0;
+}